@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "AddressOptimizer.h"
+
+#include <DRAMSys/simulation/AddressDecoder.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <systemc>
+#include <thread>
+
+using DRAMSys::Config::AddressMapping;
+
+static constexpr unsigned MAX_ITERATIONS = 100;
+
+static unsigned entry(const std::unordered_map<std::string, unsigned int>& entries,
+                      std::initializer_list<std::string_view> names,
+                      unsigned fallback)
+{
+    for (std::string_view name : names)
+    {
+        if (auto it = entries.find(std::string(name)); it != entries.end())
+            return it->second;
+    }
+    return fallback;
+}
+
+static std::vector<unsigned>
+bitsOf(const std::optional<std::vector<AddressMapping::BitEntry>>& bits)
+{
+    std::vector<unsigned> result;
+    if (!bits)
+        return result;
+
+    // For XOR gates only the bit that is overwritten belongs to the field
+    for (const auto& bitEntry : *bits)
+    {
+        if (const auto* bit = std::get_if<unsigned>(&bitEntry))
+            result.push_back(*bit);
+        else
+            result.push_back(std::get<std::vector<unsigned>>(bitEntry).at(0));
+    }
+    return result;
+}
+
+AddressOptimizer::AddressOptimizer(const DRAMSys::Config::Configuration& configuration,
+                                   std::vector<uint64_t> addresses,
+                                   unsigned threads) :
+    addresses(std::move(addresses)),
+    threads(std::max(threads, 1U))
+{
+    const auto& architecture = configuration.memspec.memarchitecturespec.entries;
+    const auto& timing = configuration.memspec.memtimingspec.entries;
+
+    unsigned burstLength = entry(architecture, {"maxBurstLength", "burstLength"}, 8);
+    unsigned dataRate = entry(architecture, {"dataRate"}, 2);
+    burstCycles = std::max(burstLength / std::max(dataRate, 1U), 1U);
+    rowMissPenalty =
+        entry(timing, {"RP", "RPpb", "RPAB"}, 15) + entry(timing, {"RCD", "RCDRD"}, 15);
+
+    const AddressMapping& mapping = configuration.addressmapping;
+    byteBits = bitsOf(mapping.BYTE_BIT);
+
+    std::vector<unsigned> columnBits = bitsOf(mapping.COLUMN_BIT);
+    std::sort(columnBits.begin(), columnBits.end());
+    auto burstBits = std::min(static_cast<std::size_t>(std::log2(burstLength)), columnBits.size());
+    burstColumnBits.assign(columnBits.begin(), columnBits.begin() + burstBits);
+
+    std::vector<std::pair<unsigned, Field>> labelledBits;
+    auto addField = [&labelledBits](const std::vector<unsigned>& bits, Field field)
+    {
+        for (unsigned bit : bits)
+            labelledBits.emplace_back(bit, field);
+    };
+
+    pseudoChannels = !mapping.RANK_BIT && mapping.PSEUDOCHANNEL_BIT;
+
+    addField(bitsOf(mapping.CHANNEL_BIT), Field::Channel);
+    addField(bitsOf(pseudoChannels ? mapping.PSEUDOCHANNEL_BIT : mapping.RANK_BIT), Field::Rank);
+    addField(bitsOf(mapping.BANKGROUP_BIT), Field::BankGroup);
+    addField(bitsOf(mapping.BANK_BIT), Field::Bank);
+    addField(bitsOf(mapping.ROW_BIT), Field::Row);
+    addField({columnBits.begin() + burstBits, columnBits.end()}, Field::Column);
+    std::sort(labelledBits.begin(), labelledBits.end());
+
+    std::size_t rowBits = 0;
+    std::size_t xorableBits = 0;
+    for (const auto& [bit, field] : labelledBits)
+    {
+        freeBits.push_back(bit);
+        initial.labels.push_back(field);
+
+        if (field == Field::Row)
+            rowBits++;
+        else if (field == Field::Channel || field == Field::BankGroup || field == Field::Bank)
+            xorableBits++;
+    }
+
+    xorSlots = static_cast<unsigned>(std::min(rowBits, xorableBits));
+    initial.xors.assign(xorSlots, false);
+}
+
+AddressMapping AddressOptimizer::toMapping(const Candidate& candidate) const
+{
+    std::vector<unsigned> channelBits;
+    std::vector<unsigned> rankBits;
+    std::vector<unsigned> bankGroupBits;
+    std::vector<unsigned> bankBits;
+    std::vector<unsigned> rowBits;
+    std::vector<unsigned> columnBits = burstColumnBits;
+
+    for (std::size_t index = 0; index < freeBits.size(); index++)
+    {
+        switch (candidate.labels[index])
+        {
+        case Field::Channel:
+            channelBits.push_back(freeBits[index]);
+            break;
+        case Field::Rank:
+            rankBits.push_back(freeBits[index]);
+            break;
+        case Field::BankGroup:
+            bankGroupBits.push_back(freeBits[index]);
+            break;
+        case Field::Bank:
+            bankBits.push_back(freeBits[index]);
+            break;
+        case Field::Row:
+            rowBits.push_back(freeBits[index]);
+            break;
+        case Field::Column:
+            columnBits.push_back(freeBits[index]);
+            break;
+        }
+    }
+
+    using BitEntries = std::optional<std::vector<AddressMapping::BitEntry>>;
+
+    auto plain = [](const std::vector<unsigned>& bits) -> BitEntries
+    {
+        if (bits.empty())
+            return std::nullopt;
+        return std::vector<AddressMapping::BitEntry>(bits.begin(), bits.end());
+    };
+
+    // XOR slots are assigned to the channel, bank group and bank bits in this order, slot i
+    // combines its bit with the i-th lowest row bit
+    unsigned slot = 0;
+    auto xored = [&candidate, &rowBits, &slot](const std::vector<unsigned>& bits) -> BitEntries
+    {
+        if (bits.empty())
+            return std::nullopt;
+
+        std::vector<AddressMapping::BitEntry> entries;
+        for (unsigned bit : bits)
+        {
+            if (slot < candidate.xors.size() && candidate.xors[slot])
+                entries.emplace_back(std::vector<unsigned>{bit, rowBits[slot]});
+            else
+                entries.emplace_back(bit);
+
+            if (slot < candidate.xors.size())
+                slot++;
+        }
+        return entries;
+    };
+
+    AddressMapping mapping;
+    mapping.BYTE_BIT = plain(byteBits);
+    mapping.COLUMN_BIT = plain(columnBits);
+    mapping.ROW_BIT = plain(rowBits);
+    mapping.CHANNEL_BIT = xored(channelBits);
+    mapping.BANKGROUP_BIT = xored(bankGroupBits);
+    mapping.BANK_BIT = xored(bankBits);
+
+    if (pseudoChannels)
+        mapping.PSEUDOCHANNEL_BIT = plain(rankBits);
+    else
+        mapping.RANK_BIT = plain(rankBits);
+
+    return mapping;
+}
+
+AddressOptimizer::Result AddressOptimizer::evaluate(const AddressMapping& mapping) const
+{
+    struct BankState
+    {
+        unsigned openRow = std::numeric_limits<unsigned>::max();
+        uint64_t ready = 0;
+    };
+
+    DRAMSys::AddressDecoder decoder(mapping);
+
+    auto fieldSize = [](const std::optional<std::vector<AddressMapping::BitEntry>>& bits)
+    { return std::size_t(1) << (bits ? bits->size() : 0); };
+
+    std::size_t channels = fieldSize(mapping.CHANNEL_BIT);
+    std::size_t banksPerChannel = fieldSize(mapping.RANK_BIT) *
+                                  fieldSize(mapping.PSEUDOCHANNEL_BIT) *
+                                  fieldSize(mapping.BANKGROUP_BIT) * fieldSize(mapping.BANK_BIT);
+
+    std::vector<BankState> banks(channels * banksPerChannel);
+    std::vector<uint64_t> channelBusy(channels);
+    uint64_t maxAddress = decoder.maxAddress();
+
+    // All requests are issued in trace order as early as possible. A row miss delays the bank,
+    // the data bursts of a channel are serialized on its data bus.
+    Result result;
+    for (uint64_t address : addresses)
+    {
+        DRAMSys::DecodedAddress decodedAddress = decoder.decodeAddress(address & maxAddress);
+        BankState& bank = banks[decodedAddress.channel * banksPerChannel + decodedAddress.bank];
+
+        uint64_t start = bank.ready;
+        if (bank.openRow != decodedAddress.row)
+        {
+            start += rowMissPenalty;
+            bank.openRow = decodedAddress.row;
+            result.rowMisses++;
+        }
+
+        uint64_t& bus = channelBusy[decodedAddress.channel];
+        bus = std::max(start, bus) + burstCycles;
+        bank.ready = bus;
+    }
+
+    result.cycles = *std::max_element(channelBusy.begin(), channelBusy.end());
+    return result;
+}
+
+std::vector<AddressOptimizer::Result>
+AddressOptimizer::evaluate(const std::vector<Candidate>& candidates) const
+{
+    std::vector<Result> results(candidates.size());
+    std::atomic<std::size_t> nextCandidate{0};
+
+    auto worker = [&]()
+    {
+        for (std::size_t index = nextCandidate++; index < candidates.size();
+             index = nextCandidate++)
+            results[index] = evaluate(toMapping(candidates[index]));
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned thread = 1; thread < threads; thread++)
+        workers.emplace_back(worker);
+
+    worker();
+
+    for (auto& thread : workers)
+        thread.join();
+
+    return results;
+}
+
+std::vector<AddressOptimizer::Candidate>
+AddressOptimizer::neighbours(const Candidate& candidate) const
+{
+    std::vector<Candidate> result;
+
+    for (std::size_t first = 0; first < candidate.labels.size(); first++)
+    {
+        for (std::size_t second = first + 1; second < candidate.labels.size(); second++)
+        {
+            if (candidate.labels[first] == candidate.labels[second])
+                continue;
+
+            Candidate swapped = candidate;
+            std::swap(swapped.labels[first], swapped.labels[second]);
+            result.push_back(std::move(swapped));
+        }
+    }
+
+    for (unsigned slot = 0; slot < xorSlots; slot++)
+    {
+        Candidate toggled = candidate;
+        toggled.xors[slot] = !toggled.xors[slot];
+        result.push_back(std::move(toggled));
+    }
+
+    return result;
+}
+
+AddressOptimizer::Candidate AddressOptimizer::canonical(const std::vector<Field>& order) const
+{
+    Candidate candidate = initial;
+    candidate.labels.clear();
+
+    for (Field field : order)
+    {
+        auto count = std::count(initial.labels.begin(), initial.labels.end(), field);
+        candidate.labels.insert(candidate.labels.end(), count, field);
+    }
+
+    return candidate;
+}
+
+AddressMapping AddressOptimizer::optimize() const
+{
+    // Fields listed from the lowest to the highest address bits
+    std::vector<Candidate> starts = {
+        initial,
+        canonical({Field::Column,
+                   Field::Channel,
+                   Field::BankGroup,
+                   Field::Bank,
+                   Field::Rank,
+                   Field::Row}),
+        canonical({Field::Channel,
+                   Field::BankGroup,
+                   Field::Bank,
+                   Field::Column,
+                   Field::Rank,
+                   Field::Row})};
+
+    std::vector<Result> startResults = evaluate(starts);
+
+    Candidate best = starts.front();
+    Result bestResult = startResults.front();
+
+    for (std::size_t start = 0; start < starts.size(); start++)
+    {
+        Candidate current = starts[start];
+        Result currentResult = startResults[start];
+
+        for (unsigned iteration = 0; iteration < MAX_ITERATIONS; iteration++)
+        {
+            std::vector<Candidate> candidates = neighbours(current);
+            if (candidates.empty())
+                break;
+
+            std::vector<Result> results = evaluate(candidates);
+            auto bestNeighbour = std::min_element(results.begin(), results.end());
+
+            if (!(*bestNeighbour < currentResult))
+                break;
+
+            current = candidates[bestNeighbour - results.begin()];
+            currentResult = *bestNeighbour;
+        }
+
+        std::cout << "Start " << start << ": " << currentResult.cycles << " cycles, "
+                  << currentResult.rowMisses << " row misses" << std::endl;
+
+        if (currentResult < bestResult)
+        {
+            best = current;
+            bestResult = currentResult;
+        }
+    }
+
+    return toMapping(best);
+}
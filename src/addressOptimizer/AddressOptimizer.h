@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <DRAMSys/config/DRAMSysConfiguration.h>
+
+#include <cstdint>
+#include <vector>
+
+// Searches address mappings for a trace with a lightweight bank and row conflict model instead of
+// a full simulation. Starting from the configured mapping and two canonical layouts, the search
+// climbs along bit swaps between fields and XORs of bank, bank group and channel bits with row
+// bits. All neighbours of a candidate are evaluated in parallel.
+class AddressOptimizer
+{
+public:
+    struct Result
+    {
+        uint64_t cycles = 0;
+        uint64_t rowMisses = 0;
+
+        bool operator<(const Result& other) const
+        {
+            return cycles < other.cycles || (cycles == other.cycles && rowMisses < other.rowMisses);
+        }
+    };
+
+    AddressOptimizer(const DRAMSys::Config::Configuration& configuration,
+                     std::vector<uint64_t> addresses,
+                     unsigned threads);
+
+    [[nodiscard]] Result evaluate(const DRAMSys::Config::AddressMapping& mapping) const;
+    [[nodiscard]] DRAMSys::Config::AddressMapping optimize() const;
+
+private:
+    enum class Field
+    {
+        Channel,
+        Rank,
+        BankGroup,
+        Bank,
+        Row,
+        Column
+    };
+
+    // Free address bits in ascending order are assigned to the fields in labels. Each entry of
+    // xors enables the XOR of one channel, bank group or bank bit with a low row bit.
+    struct Candidate
+    {
+        std::vector<Field> labels;
+        std::vector<bool> xors;
+    };
+
+    [[nodiscard]] DRAMSys::Config::AddressMapping toMapping(const Candidate& candidate) const;
+    [[nodiscard]] std::vector<Candidate> neighbours(const Candidate& candidate) const;
+    [[nodiscard]] std::vector<Result> evaluate(const std::vector<Candidate>& candidates) const;
+    [[nodiscard]] Candidate canonical(const std::vector<Field>& order) const;
+
+    const std::vector<uint64_t> addresses;
+    const unsigned threads;
+
+    // Timings of the conflict model in clock cycles
+    uint64_t rowMissPenalty = 0;
+    uint64_t burstCycles = 0;
+
+    // Byte bits and the column bits of a maximum burst stay in place
+    std::vector<unsigned> byteBits;
+    std::vector<unsigned> burstColumnBits;
+    std::vector<unsigned> freeBits;
+    bool pseudoChannels = false;
+
+    Candidate initial;
+    unsigned xorSlots = 0;
+};
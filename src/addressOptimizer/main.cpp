@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "AddressOptimizer.h"
+
+#include <DRAMSys/config/DRAMSysConfiguration.h>
+#include <DRAMSys/simulation/AddressDecoder.h>
+#include <simulator/player/StlParser.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+
+// Every candidate mapping is evaluated on all requests, so they are kept in memory. Larger traces
+// are truncated by default, the first requests are usually representative enough.
+static constexpr uint64_t DEFAULT_MAX_REQUESTS = 1000000;
+static constexpr std::size_t BLOCK_SIZE = 10000;
+
+static void printResult(std::string_view label,
+                        const AddressOptimizer::Result& result,
+                        std::size_t requests)
+{
+    std::cout << label << result.cycles << " cycles, " << std::fixed << std::setprecision(2)
+              << (requests - result.rowMisses) * 100.0 / requests << " % row hits" << std::endl;
+}
+
+int sc_main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: " << argv[0]
+                  << " <configuration> <trace> [output mapping] [resource directory] [max requests]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path outputPath = "optimized_addressmapping.json";
+    if (argc >= 4)
+        outputPath = argv[3];
+
+    std::filesystem::path resourceDirectory = DRAMSYS_RESOURCE_DIR;
+    if (argc >= 5)
+        resourceDirectory = argv[4];
+
+    // A limit of 0 uses the whole trace
+    uint64_t maxRequests = DEFAULT_MAX_REQUESTS;
+    if (argc >= 6)
+        maxRequests = std::stoull(argv[5]);
+    if (maxRequests == 0)
+        maxRequests = std::numeric_limits<uint64_t>::max();
+
+    DRAMSys::Config::Configuration configuration =
+        DRAMSys::Config::from_path(argv[1], resourceDirectory.c_str());
+
+    uint64_t addressOffset = configuration.simconfig.AddressOffset.value_or(0);
+
+    StlParser parser(argv[2], 0, false);
+    std::vector<uint64_t> addresses;
+    addresses.reserve(std::min(parser.numberOfLines(), maxRequests));
+
+    TraceBlock block;
+    while (addresses.size() < maxRequests)
+    {
+        parser.parse(block, std::min<uint64_t>(BLOCK_SIZE, maxRequests - addresses.size()));
+        if (block.entries.empty())
+            break;
+
+        for (const TraceEntry& entry : block.entries)
+            addresses.push_back(entry.address - addressOffset);
+    }
+
+    std::size_t requests = addresses.size();
+    if (requests < parser.numberOfLines())
+    {
+        std::cout << "Warning: Only the first " << requests << " of " << parser.numberOfLines()
+                  << " requests of the trace are used" << std::endl;
+    }
+
+    AddressOptimizer optimizer(
+        configuration, std::move(addresses), std::thread::hardware_concurrency());
+
+    AddressOptimizer::Result initialResult = optimizer.evaluate(configuration.addressmapping);
+    DRAMSys::Config::AddressMapping mapping = optimizer.optimize();
+    AddressOptimizer::Result optimizedResult = optimizer.evaluate(mapping);
+
+    std::cout << "Requests:           " << requests << std::endl;
+    printResult("Configured mapping: ", initialResult, requests);
+    printResult("Optimized mapping:  ", optimizedResult, requests);
+
+    DRAMSys::AddressDecoder(mapping).print();
+
+    nlohmann::json json;
+    json[std::string(DRAMSys::Config::AddressMapping::KEY)] = mapping;
+    std::ofstream outputFile(outputPath);
+    outputFile << std::setw(4) << json << std::endl;
+
+    std::cout << "Mapping written to " << outputPath << std::endl;
+
+    return 0;
+}
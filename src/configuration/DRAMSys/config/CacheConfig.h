@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DRAMSYSCONFIGURATION_CACHECONFIG_H
+#define DRAMSYSCONFIGURATION_CACHECONFIG_H
+
+#include "DRAMSys/util/json.h"
+
+#include <optional>
+
+namespace DRAMSys::Config
+{
+
+enum class ReplacementPolicyType
+{
+    Lru,
+    TreePlru,
+    Srrip,
+    Random,
+    Invalid = -1
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(ReplacementPolicyType,
+                             {{ReplacementPolicyType::Invalid, nullptr},
+                              {ReplacementPolicyType::Lru, "Lru"},
+                              {ReplacementPolicyType::TreePlru, "TreePlru"},
+                              {ReplacementPolicyType::Srrip, "Srrip"},
+                              {ReplacementPolicyType::Random, "Random"}})
+
+enum class PrefetcherType
+{
+    None,
+    NextLine,
+    Stride,
+    Stream,
+    Invalid = -1
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(PrefetcherType,
+                             {{PrefetcherType::Invalid, nullptr},
+                              {PrefetcherType::None, "None"},
+                              {PrefetcherType::NextLine, "NextLine"},
+                              {PrefetcherType::Stride, "Stride"},
+                              {PrefetcherType::Stream, "Stream"}})
+
+struct CacheConfig
+{
+    std::optional<uint64_t> ClkMhz;
+    std::optional<uint64_t> Size;
+    std::optional<unsigned int> Associativity;
+    std::optional<unsigned int> LineSize;
+    std::optional<unsigned int> MshrDepth;
+    std::optional<unsigned int> WriteBufferDepth;
+    std::optional<unsigned int> MaxTargetListSize;
+    std::optional<unsigned int> HitCycles;
+    std::optional<ReplacementPolicyType> ReplacementPolicy;
+    std::optional<PrefetcherType> Prefetcher;
+    std::optional<unsigned int> PrefetchDegree;
+    std::optional<unsigned int> PrefetchTableSize;
+};
+
+NLOHMANN_JSONIFY_ALL_THINGS(CacheConfig,
+                            ClkMhz,
+                            Size,
+                            Associativity,
+                            LineSize,
+                            MshrDepth,
+                            WriteBufferDepth,
+                            MaxTargetListSize,
+                            HitCycles,
+                            ReplacementPolicy,
+                            Prefetcher,
+                            PrefetchDegree,
+                            PrefetchTableSize)
+
+} // namespace DRAMSys::Config
+
+#endif // DRAMSYSCONFIGURATION_CACHECONFIG_H
@@ -51,6 +51,7 @@ enum class PagePolicyType
     OpenAdaptive,
     Closed,
     ClosedAdaptive,
+    Predictive,
     Invalid = -1
 };
 
@@ -61,6 +62,7 @@ NLOHMANN_JSON_SERIALIZE_ENUM(PagePolicyType,
                                  {PagePolicyType::OpenAdaptive, "OpenAdaptive"},
                                  {PagePolicyType::Closed, "Closed"},
                                  {PagePolicyType::ClosedAdaptive, "ClosedAdaptive"},
+                                 {PagePolicyType::Predictive, "Predictive"},
                              })
 
 enum class SchedulerType
@@ -70,6 +72,7 @@ enum class SchedulerType
     FrFcfsGrp,
     GrpFrFcfs,
     GrpFrFcfsWm,
+    FrFcfsQoS,
     Invalid = -1
 };
 
@@ -79,7 +82,8 @@ NLOHMANN_JSON_SERIALIZE_ENUM(SchedulerType,
                               {SchedulerType::FrFcfs, "FrFcfs"},
                               {SchedulerType::FrFcfsGrp, "FrFcfsGrp"},
                               {SchedulerType::GrpFrFcfs, "GrpFrFcfs"},
-                              {SchedulerType::GrpFrFcfsWm, "GrpFrFcfsWm"}})
+                              {SchedulerType::GrpFrFcfsWm, "GrpFrFcfsWm"},
+                              {SchedulerType::FrFcfsQoS, "FrFcfsQoS"}})
 
 enum class SchedulerBufferType
 {
@@ -160,6 +164,7 @@ enum class ArbiterType
     Simple,
     Fifo,
     Reorder,
+    QoS,
     Invalid = -1
 };
 
@@ -167,7 +172,8 @@ NLOHMANN_JSON_SERIALIZE_ENUM(ArbiterType,
                              {{ArbiterType::Invalid, nullptr},
                               {ArbiterType::Simple, "Simple"},
                               {ArbiterType::Fifo, "Fifo"},
-                              {ArbiterType::Reorder, "Reorder"}})
+                              {ArbiterType::Reorder, "Reorder"},
+                              {ArbiterType::QoS, "QoS"}})
 
 struct McConfig
 {
@@ -175,9 +181,14 @@ struct McConfig
     static constexpr std::string_view SUB_DIR = "mcconfig";
 
     std::optional<PagePolicyType> PagePolicy;
+    std::optional<unsigned int> PredictorTableSize;
     std::optional<SchedulerType> Scheduler;
     std::optional<unsigned int> HighWatermark;
     std::optional<unsigned int> LowWatermark;
+    std::optional<bool> AdaptiveWatermarks;
+    std::optional<unsigned int> MaxRequestAge;
+    std::optional<unsigned int> BlacklistingThreshold;
+    std::optional<unsigned int> BlacklistingInterval;
     std::optional<SchedulerBufferType> SchedulerBuffer;
     std::optional<unsigned int> RequestBufferSize;
     std::optional<unsigned int> RequestBufferSizeRead;
@@ -203,9 +214,14 @@ struct McConfig
 
 NLOHMANN_JSONIFY_ALL_THINGS(McConfig,
                             PagePolicy,
+                            PredictorTableSize,
                             Scheduler,
                             HighWatermark,
                             LowWatermark,
+                            AdaptiveWatermarks,
+                            MaxRequestAge,
+                            BlacklistingThreshold,
+                            BlacklistingInterval,
                             SchedulerBuffer,
                             RequestBufferSize,
                             RequestBufferSizeRead,
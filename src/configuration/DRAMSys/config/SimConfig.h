@@ -36,6 +36,7 @@
 #ifndef DRAMSYSCONFIGURATION_SIMCONFIG_H
 #define DRAMSYSCONFIGURATION_SIMCONFIG_H
 
+#include "DRAMSys/config/CacheConfig.h"
 #include "DRAMSys/util/json.h"
 
 #include <optional>
@@ -64,10 +65,21 @@ struct SimConfig
     std::optional<bool> CheckTLM2Protocol;
     std::optional<bool> DatabaseRecording;
     std::optional<bool> Debug;
+    std::optional<bool> EccModule;
     std::optional<bool> EnableWindowing;
+    std::optional<uint64_t> FastForwardCycles;
+    std::optional<CacheConfig> LastLevelCache;
     std::optional<bool> PowerAnalysis;
+    std::optional<std::string> RestoreCheckpoint;
+    std::optional<uint64_t> SamplingInterval;
+    std::optional<uint64_t> SamplingWarmup;
+    std::optional<uint64_t> SamplingWindow;
+    std::optional<std::string> SaveCheckpoint;
+    std::optional<uint64_t> SaveCheckpointCycle;
+    std::optional<uint64_t> SaveCheckpointTimeout;
     std::optional<std::string> SimulationName;
     std::optional<bool> SimulationProgressBar;
+    std::optional<unsigned int> StoreFillPattern;
     std::optional<StoreModeType> StoreMode;
     std::optional<bool> ThermalSimulation;
     std::optional<bool> UseMalloc;
@@ -79,10 +91,21 @@ NLOHMANN_JSONIFY_ALL_THINGS(SimConfig,
                             CheckTLM2Protocol,
                             DatabaseRecording,
                             Debug,
+                            EccModule,
                             EnableWindowing,
+                            FastForwardCycles,
+                            LastLevelCache,
                             PowerAnalysis,
+                            RestoreCheckpoint,
+                            SamplingInterval,
+                            SamplingWarmup,
+                            SamplingWindow,
+                            SaveCheckpoint,
+                            SaveCheckpointCycle,
+                            SaveCheckpointTimeout,
                             SimulationName,
                             SimulationProgressBar,
+                            StoreFillPattern,
                             StoreMode,
                             ThermalSimulation,
                             UseMalloc,
@@ -36,6 +36,7 @@
 #ifndef DRAMSYSCONFIGURATION_TRACESETUP_H
 #define DRAMSYSCONFIGURATION_TRACESETUP_H
 
+#include "DRAMSys/config/CacheConfig.h"
 #include "DRAMSys/util/json.h"
 
 #include <optional>
@@ -62,13 +63,35 @@ enum class AddressDistribution
 {
     Random,
     Sequential,
+    Strided,
+    Zipf,
+    Hotspot,
+    BankConflict,
     Invalid = -1
 };
 
 NLOHMANN_JSON_SERIALIZE_ENUM(AddressDistribution,
                              {{AddressDistribution::Invalid, nullptr},
                               {AddressDistribution::Random, "random"},
-                              {AddressDistribution::Sequential, "sequential"}})
+                              {AddressDistribution::Sequential, "sequential"},
+                              {AddressDistribution::Strided, "strided"},
+                              {AddressDistribution::Zipf, "zipf"},
+                              {AddressDistribution::Hotspot, "hotspot"},
+                              {AddressDistribution::BankConflict, "bankConflict"}})
+
+enum class ArrivalProcess
+{
+    Constant,
+    Poisson,
+    Bursty,
+    Invalid = -1
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(ArrivalProcess,
+                             {{ArrivalProcess::Invalid, nullptr},
+                              {ArrivalProcess::Constant, "constant"},
+                              {ArrivalProcess::Poisson, "poisson"},
+                              {ArrivalProcess::Bursty, "bursty"}})
 
 struct TracePlayer
 {
@@ -76,10 +99,32 @@ struct TracePlayer
     std::string name;
     std::optional<unsigned int> maxPendingReadRequests;
     std::optional<unsigned int> maxPendingWriteRequests;
+    std::optional<unsigned int> priority;
+    std::optional<unsigned int> weight;
+    std::optional<double> deadline;
+    std::optional<CacheConfig> cache;
+
+    std::optional<uint64_t> loops;
+    std::optional<double> timeScale;
+    std::optional<uint64_t> addressOffset;
+    std::optional<uint64_t> addressMask;
+    std::optional<bool> predecodeAddresses;
 };
 
-NLOHMANN_JSONIFY_ALL_THINGS(
-    TracePlayer, clkMhz, name, maxPendingReadRequests, maxPendingWriteRequests)
+NLOHMANN_JSONIFY_ALL_THINGS(TracePlayer,
+                            clkMhz,
+                            name,
+                            maxPendingReadRequests,
+                            maxPendingWriteRequests,
+                            priority,
+                            weight,
+                            deadline,
+                            cache,
+                            loops,
+                            timeScale,
+                            addressOffset,
+                            addressMask,
+                            predecodeAddresses)
 
 struct TrafficGeneratorActiveState
 {
@@ -91,6 +136,11 @@ struct TrafficGeneratorActiveState
     std::optional<uint64_t> addressIncrement;
     std::optional<uint64_t> minAddress;
     std::optional<uint64_t> maxAddress;
+    std::optional<unsigned> numStreams;
+    std::optional<double> zipfExponent;
+    std::optional<uint64_t> blockSize;
+    std::optional<double> hotspotProbability;
+    std::optional<double> hotspotSize;
 };
 
 NLOHMANN_JSONIFY_ALL_THINGS(TrafficGeneratorActiveState,
@@ -100,7 +150,12 @@ NLOHMANN_JSONIFY_ALL_THINGS(TrafficGeneratorActiveState,
                             addressDistribution,
                             addressIncrement,
                             minAddress,
-                            maxAddress)
+                            maxAddress,
+                            numStreams,
+                            zipfExponent,
+                            blockSize,
+                            hotspotProbability,
+                            hotspotSize)
 
 struct TrafficGeneratorIdleState
 {
@@ -126,18 +181,33 @@ struct TrafficGenerator
     std::string name;
     std::optional<unsigned int> maxPendingReadRequests;
     std::optional<unsigned int> maxPendingWriteRequests;
+    std::optional<unsigned int> priority;
+    std::optional<unsigned int> weight;
+    std::optional<double> deadline;
+    std::optional<CacheConfig> cache;
 
     std::optional<uint64_t> seed;
     std::optional<uint64_t> maxTransactions;
     std::optional<unsigned> dataLength;
     std::optional<unsigned> dataAlignment;
 
+    std::optional<double> targetBandwidth;
+    std::optional<double> targetRequestRate;
+    std::optional<ArrivalProcess> arrivalProcess;
+    std::optional<unsigned> burstSize;
+    std::optional<unsigned> sweepSteps;
+
     uint64_t numRequests{};
     double rwRatio{};
     AddressDistribution addressDistribution;
     std::optional<uint64_t> addressIncrement;
     std::optional<uint64_t> minAddress;
     std::optional<uint64_t> maxAddress;
+    std::optional<unsigned> numStreams;
+    std::optional<double> zipfExponent;
+    std::optional<uint64_t> blockSize;
+    std::optional<double> hotspotProbability;
+    std::optional<double> hotspotSize;
 };
 
 NLOHMANN_JSONIFY_ALL_THINGS(TrafficGenerator,
@@ -145,16 +215,30 @@ NLOHMANN_JSONIFY_ALL_THINGS(TrafficGenerator,
                             name,
                             maxPendingReadRequests,
                             maxPendingWriteRequests,
+                            priority,
+                            weight,
+                            deadline,
+                            cache,
                             seed,
                             maxTransactions,
                             dataLength,
                             dataAlignment,
+                            targetBandwidth,
+                            targetRequestRate,
+                            arrivalProcess,
+                            burstSize,
+                            sweepSteps,
                             numRequests,
                             rwRatio,
                             addressDistribution,
                             addressIncrement,
                             minAddress,
-                            maxAddress)
+                            maxAddress,
+                            numStreams,
+                            zipfExponent,
+                            blockSize,
+                            hotspotProbability,
+                            hotspotSize)
 
 struct TrafficGeneratorStateMachine
 {
@@ -162,11 +246,22 @@ struct TrafficGeneratorStateMachine
     std::string name;
     std::optional<unsigned int> maxPendingReadRequests;
     std::optional<unsigned int> maxPendingWriteRequests;
+    std::optional<unsigned int> priority;
+    std::optional<unsigned int> weight;
+    std::optional<double> deadline;
+    std::optional<CacheConfig> cache;
 
     std::optional<uint64_t> seed;
     std::optional<uint64_t> maxTransactions;
     std::optional<unsigned> dataLength;
     std::optional<unsigned> dataAlignment;
+
+    std::optional<double> targetBandwidth;
+    std::optional<double> targetRequestRate;
+    std::optional<ArrivalProcess> arrivalProcess;
+    std::optional<unsigned> burstSize;
+    std::optional<unsigned> sweepSteps;
+
     std::vector<std::variant<TrafficGeneratorActiveState, TrafficGeneratorIdleState>> states;
     std::vector<TrafficGeneratorStateTransition> transitions;
 };
@@ -176,10 +271,19 @@ NLOHMANN_JSONIFY_ALL_THINGS(TrafficGeneratorStateMachine,
                             name,
                             maxPendingReadRequests,
                             maxPendingWriteRequests,
+                            priority,
+                            weight,
+                            deadline,
+                            cache,
                             seed,
                             maxTransactions,
                             dataLength,
                             dataAlignment,
+                            targetBandwidth,
+                            targetRequestRate,
+                            arrivalProcess,
+                            burstSize,
+                            sweepSteps,
                             states,
                             transitions)
 
@@ -189,6 +293,10 @@ struct RowHammer
     std::string name;
     std::optional<unsigned int> maxPendingReadRequests;
     std::optional<unsigned int> maxPendingWriteRequests;
+    std::optional<unsigned int> priority;
+    std::optional<unsigned int> weight;
+    std::optional<double> deadline;
+    std::optional<CacheConfig> cache;
 
     uint64_t numRequests{};
     uint64_t rowIncrement{};
@@ -199,6 +307,10 @@ NLOHMANN_JSONIFY_ALL_THINGS(RowHammer,
                             name,
                             maxPendingReadRequests,
                             maxPendingWriteRequests,
+                            priority,
+                            weight,
+                            deadline,
+                            cache,
                             numRequests,
                             rowIncrement)
 
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Checkpoint.h"
+
+#include <sstream>
+#include <string>
+
+namespace DRAMSys::Checkpoint
+{
+
+void writeBlock(std::ostream& stream, const std::string& data)
+{
+    writeValue(stream, static_cast<uint64_t>(data.size()));
+    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+std::string readBlock(std::istream& stream)
+{
+    uint64_t size = 0;
+    readValue(stream, size);
+
+    std::string data;
+    if (stream)
+    {
+        data.resize(size);
+        stream.read(data.data(), static_cast<std::streamsize>(size));
+    }
+    return data;
+}
+
+void writeSection(std::ostream& stream, const std::string& tag, const Serialize& component)
+{
+    writeBlock(stream, tag);
+
+    std::ostream::pos_type lengthPosition = stream.tellp();
+    if (lengthPosition == std::ostream::pos_type(-1))
+    {
+        // Streams without positioning need the length up front
+        std::ostringstream section;
+        component.serialize(section);
+        writeBlock(stream, section.str());
+        return;
+    }
+
+    // The component is written directly into the stream and the length is filled in afterwards,
+    // so that large components like the memory image are not copied
+    writeValue(stream, uint64_t{0});
+    std::ostream::pos_type start = stream.tellp();
+    component.serialize(stream);
+    std::ostream::pos_type end = stream.tellp();
+
+    stream.seekp(lengthPosition);
+    writeValue(stream, static_cast<uint64_t>(end - start));
+    stream.seekp(end);
+}
+
+void readSection(std::istream& stream, const std::string& tag, Deserialize& component)
+{
+    std::string sectionTag = readBlock(stream);
+    uint64_t length = 0;
+    readValue(stream, length);
+
+    if (!stream)
+        SC_REPORT_FATAL("Checkpoint", "Unexpected end of checkpoint");
+
+    if (sectionTag != tag)
+    {
+        SC_REPORT_WARNING("Checkpoint",
+                          ("Skipping checkpoint section " + sectionTag + " instead of " + tag +
+                           ", the component keeps its initial state")
+                              .c_str());
+        stream.ignore(static_cast<std::streamsize>(length));
+        return;
+    }
+
+    std::istream::pos_type start = stream.tellg();
+    if (start == std::istream::pos_type(-1))
+    {
+        // Streams without positioning cannot check the length of the section in place
+        std::string data(length, '\0');
+        stream.read(data.data(), static_cast<std::streamsize>(length));
+        std::istringstream section(data);
+        component.deserialize(section);
+
+        if (!stream || !section)
+            SC_REPORT_FATAL("Checkpoint",
+                            ("Checkpoint section " + tag + " does not match the configuration")
+                                .c_str());
+        return;
+    }
+
+    component.deserialize(stream);
+
+    if (!stream || static_cast<uint64_t>(stream.tellg() - start) > length)
+        SC_REPORT_FATAL("Checkpoint",
+                        ("Checkpoint section " + tag + " does not match the configuration")
+                            .c_str());
+
+    stream.seekg(start + static_cast<std::streamoff>(length));
+}
+
+void skipSection(std::istream& stream)
+{
+    readBlock(stream);
+    uint64_t length = 0;
+    readValue(stream, length);
+    stream.ignore(static_cast<std::streamsize>(length));
+
+    if (!stream)
+        SC_REPORT_FATAL("Checkpoint", "Unexpected end of checkpoint");
+}
+
+} // namespace DRAMSys::Checkpoint
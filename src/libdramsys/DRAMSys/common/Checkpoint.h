@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "DRAMSys/common/Deserialize.h"
+#include "DRAMSys/common/Serialize.h"
+
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <systemc>
+#include <type_traits>
+
+// Building blocks of the binary checkpoint format. Values are stored in host byte order.
+// Points in time are stored relative to the simulation time at which the checkpoint is taken,
+// so that a checkpoint can be restored into a simulation that starts again at zero.
+// Containers that are sized by the configuration (e.g. one entry per bank) must be restored
+// into a container of the same size.
+namespace DRAMSys::Checkpoint
+{
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>> writeValue(std::ostream& stream,
+                                                                            const T& value);
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>> readValue(std::istream& stream,
+                                                                           T& value);
+inline void writeValue(std::ostream& stream, const sc_core::sc_time& time);
+inline void readValue(std::istream& stream, sc_core::sc_time& time);
+template <typename T> void writeValue(std::ostream& stream, const std::queue<T>& queue);
+template <typename T> void readValue(std::istream& stream, std::queue<T>& queue);
+template <typename Range>
+auto writeValue(std::ostream& stream, const Range& range) -> decltype(std::begin(range), void());
+template <typename Range>
+auto readValue(std::istream& stream, Range& range) -> decltype(std::begin(range), void());
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>> writeValue(std::ostream& stream,
+                                                                            const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>> readValue(std::istream& stream,
+                                                                           T& value)
+{
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+inline void writeValue(std::ostream& stream, const sc_core::sc_time& time)
+{
+    bool never = time == sc_core::sc_max_time();
+    writeValue(stream, never);
+
+    if (!never)
+        writeValue(stream, static_cast<int64_t>(time.value() - sc_core::sc_time_stamp().value()));
+}
+
+inline void readValue(std::istream& stream, sc_core::sc_time& time)
+{
+    bool never = false;
+    readValue(stream, never);
+
+    if (never)
+    {
+        time = sc_core::sc_max_time();
+        return;
+    }
+
+    int64_t offset = 0;
+    readValue(stream, offset);
+
+    // Points in time before the start of the restored simulation are clamped to zero
+    uint64_t now = sc_core::sc_time_stamp().value();
+    uint64_t value = offset < 0 && static_cast<uint64_t>(-offset) > now
+                         ? 0
+                         : now + static_cast<uint64_t>(offset);
+    time = sc_core::sc_time::from_value(value);
+}
+
+template <typename T> void writeValue(std::ostream& stream, const std::queue<T>& queue)
+{
+    std::queue<T> copy = queue;
+    writeValue(stream, static_cast<uint64_t>(copy.size()));
+
+    while (!copy.empty())
+    {
+        writeValue(stream, copy.front());
+        copy.pop();
+    }
+}
+
+template <typename T> void readValue(std::istream& stream, std::queue<T>& queue)
+{
+    uint64_t size = 0;
+    readValue(stream, size);
+
+    queue = {};
+    for (uint64_t i = 0; i < size && stream; i++)
+    {
+        T value{};
+        readValue(stream, value);
+        queue.push(value);
+    }
+}
+
+template <typename Range>
+auto writeValue(std::ostream& stream, const Range& range) -> decltype(std::begin(range), void())
+{
+    writeValue(stream, static_cast<uint64_t>(std::distance(std::begin(range), std::end(range))));
+
+    for (const auto& value : range)
+        writeValue(stream, value);
+}
+
+template <typename Range>
+auto readValue(std::istream& stream, Range& range) -> decltype(std::begin(range), void())
+{
+    uint64_t size = 0;
+    readValue(stream, size);
+
+    if (size != static_cast<uint64_t>(std::distance(std::begin(range), std::end(range))))
+    {
+        stream.setstate(std::ios::failbit);
+        return;
+    }
+
+    for (auto& value : range)
+        readValue(stream, value);
+}
+
+template <typename... Ts> void write(std::ostream& stream, const Ts&... values)
+{
+    (writeValue(stream, values), ...);
+}
+
+template <typename... Ts> void read(std::istream& stream, Ts&... values)
+{
+    (readValue(stream, values), ...);
+}
+
+// Length-prefixed block of data, e.g. for state whose length depends on the implementation
+void writeBlock(std::ostream& stream, const std::string& data);
+std::string readBlock(std::istream& stream);
+
+// Each component is stored in its own length-prefixed section with an explicit tag that names its
+// implementation (e.g. the configured refresh policy). A section with a different tag (e.g. when a
+// checkpoint is restored into a configuration with another refresh policy) is skipped and the
+// component keeps its initial state. Components are read and written in place, without copies.
+void writeSection(std::ostream& stream, const std::string& tag, const Serialize& component);
+void readSection(std::istream& stream, const std::string& tag, Deserialize& component);
+void skipSection(std::istream& stream);
+
+} // namespace DRAMSys::Checkpoint
+
+#endif // CHECKPOINT_H
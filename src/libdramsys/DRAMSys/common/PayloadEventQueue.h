@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PAYLOADEVENTQUEUE_H
+#define PAYLOADEVENTQUEUE_H
+
+#include <systemc>
+#include <tlm>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace DRAMSys
+{
+
+/*
+ * Drop-in replacement for tlm_utils::peq_with_cb_and_phase for modules that handle many
+ * outstanding payloads at once. Timed notifications are kept in a time wheel with one bucket per
+ * clock cycle so that inserting a notification does not depend on the number of pending ones.
+ * Notifications that lie beyond the horizon of the wheel are kept in an ordered overflow map.
+ *
+ * The callback order is the same as the one of the TLM payload event queue: delta notifications
+ * are delivered in the next delta cycle before any timed notification, and notifications for the
+ * same point in time are delivered in the order they were issued.
+ */
+template <typename OWNER> class PayloadEventQueue
+{
+public:
+    using Callback = void (OWNER::*)(tlm::tlm_generic_payload&, const tlm::tlm_phase&);
+
+    PayloadEventQueue(OWNER* owner,
+                      Callback callback,
+                      const sc_core::sc_time& cyclePeriod,
+                      std::size_t numberOfBuckets = 256) :
+        owner(owner),
+        callback(callback),
+        cyclePeriod(cyclePeriod.value()),
+        bucketMask(roundUpToPowerOfTwo(numberOfBuckets) - 1),
+        buckets(bucketMask + 1)
+    {
+        sc_core::sc_spawn_options options;
+        options.spawn_method();
+        options.set_sensitivity(&event);
+        options.dont_initialize();
+        sc_core::sc_spawn([this]() { fire(); }, sc_core::sc_gen_unique_name("peq"), &options);
+    }
+
+    void notify(tlm::tlm_generic_payload& payload,
+                const tlm::tlm_phase& phase,
+                const sc_core::sc_time& delay)
+    {
+        if (delay == sc_core::SC_ZERO_TIME)
+        {
+            deltaNotifications[sc_core::sc_delta_count() & 1].push_back({delay, &payload, phase});
+            event.notify(sc_core::SC_ZERO_TIME);
+            return;
+        }
+
+        sc_core::sc_time time = sc_core::sc_time_stamp() + delay;
+        uint64_t cycle = time.value() / cyclePeriod;
+        uint64_t currentCycle = sc_core::sc_time_stamp().value() / cyclePeriod;
+
+        if (cycle - currentCycle <= bucketMask)
+            buckets[cycle & bucketMask].push_back({time, &payload, phase});
+        else
+            overflow.emplace(time, Notification{time, &payload, phase});
+
+        event.notify(delay);
+    }
+
+private:
+    struct Notification
+    {
+        sc_core::sc_time time;
+        tlm::tlm_generic_payload* payload;
+        tlm::tlm_phase phase;
+    };
+
+    OWNER* const owner;
+    const Callback callback;
+
+    const uint64_t cyclePeriod;
+    const uint64_t bucketMask;
+
+    sc_core::sc_event event;
+
+    std::vector<Notification> deltaNotifications[2];
+    std::vector<std::vector<Notification>> buckets;
+    std::multimap<sc_core::sc_time, Notification> overflow;
+
+    static uint64_t roundUpToPowerOfTwo(std::size_t value)
+    {
+        uint64_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    void fire()
+    {
+        // Delta notifications were issued in the previous delta cycle.
+        std::vector<Notification>& delta = deltaNotifications[(sc_core::sc_delta_count() & 1) ^ 1];
+        for (std::size_t i = 0; i < delta.size(); i++)
+        {
+            Notification notification = delta[i];
+            (owner->*callback)(*notification.payload, notification.phase);
+        }
+        delta.clear();
+
+        const sc_core::sc_time now = sc_core::sc_time_stamp();
+        uint64_t currentCycle = now.value() / cyclePeriod;
+
+        // Notifications end up in the overflow map only if they were issued before any notification
+        // for the same time in the wheel, so they are delivered first.
+        while (!overflow.empty() && overflow.begin()->first == now)
+        {
+            Notification notification = overflow.begin()->second;
+            overflow.erase(overflow.begin());
+            (owner->*callback)(*notification.payload, notification.phase);
+        }
+
+        // Callbacks may append to the current bucket, but never for the current time.
+        std::vector<Notification>& bucket = buckets[currentCycle & bucketMask];
+        bool delivered = false;
+        for (std::size_t i = 0; i < bucket.size(); i++)
+        {
+            if (bucket[i].time != now)
+                continue;
+
+            Notification notification = bucket[i];
+            bucket[i].payload = nullptr;
+            delivered = true;
+            (owner->*callback)(*notification.payload, notification.phase);
+        }
+
+        if (delivered)
+        {
+            std::size_t remaining = 0;
+            for (std::size_t i = 0; i < bucket.size(); i++)
+            {
+                if (bucket[i].payload != nullptr)
+                    bucket[remaining++] = bucket[i];
+            }
+            bucket.resize(remaining);
+        }
+
+        scheduleNext(now, currentCycle);
+    }
+
+    void scheduleNext(const sc_core::sc_time& now, uint64_t currentCycle)
+    {
+        bool pending = !overflow.empty();
+        sc_core::sc_time next = pending ? overflow.begin()->first : sc_core::SC_ZERO_TIME;
+
+        // All notifications in the wheel lie within bucketMask cycles from now, so the first
+        // non-empty bucket holds the earliest of them.
+        for (uint64_t cycle = currentCycle; cycle <= currentCycle + bucketMask; cycle++)
+        {
+            const std::vector<Notification>& bucket = buckets[cycle & bucketMask];
+            if (bucket.empty())
+                continue;
+
+            for (const Notification& notification : bucket)
+            {
+                if (!pending || notification.time < next)
+                    next = notification.time;
+                pending = true;
+            }
+            break;
+        }
+
+        if (pending)
+            event.notify(next - now);
+    }
+};
+
+} // namespace DRAMSys
+
+#endif // PAYLOADEVENTQUEUE_H
@@ -66,6 +66,8 @@ void ArbiterExtension::setAutoExtension(tlm::tlm_generic_payload& trans,
         extension->channel = channel;
         extension->threadPayloadID = 0;
         extension->timeOfGeneration = SC_ZERO_TIME;
+        extension->priority = 0;
+        extension->deadline = sc_max_time();
     }
     else
     {
@@ -96,9 +98,23 @@ void ArbiterExtension::setIDAndTimeOfGeneration(tlm::tlm_generic_payload& trans,
     extension->timeOfGeneration = timeOfGeneration;
 }
 
+void ArbiterExtension::setQoS(tlm::tlm_generic_payload& trans,
+                              unsigned int priority,
+                              const sc_core::sc_time& deadline)
+{
+    assert(trans.get_extension<ArbiterExtension>() != nullptr);
+
+    auto* extension = trans.get_extension<ArbiterExtension>();
+    extension->priority = priority;
+    extension->deadline = deadline;
+}
+
 tlm_extension_base* ArbiterExtension::clone() const
 {
-    return new ArbiterExtension(thread, channel, threadPayloadID, timeOfGeneration);
+    auto* extension = new ArbiterExtension(thread, channel, threadPayloadID, timeOfGeneration);
+    extension->priority = priority;
+    extension->deadline = deadline;
+    return extension;
 }
 
 void ArbiterExtension::copy_from(const tlm_extension_base& ext)
@@ -108,51 +124,8 @@ void ArbiterExtension::copy_from(const tlm_extension_base& ext)
     channel = cpyFrom.channel;
     threadPayloadID = cpyFrom.threadPayloadID;
     timeOfGeneration = cpyFrom.timeOfGeneration;
-}
-
-Thread ArbiterExtension::getThread() const
-{
-    return thread;
-}
-
-Channel ArbiterExtension::getChannel() const
-{
-    return channel;
-}
-
-uint64_t ArbiterExtension::getThreadPayloadID() const
-{
-    return threadPayloadID;
-}
-
-sc_core::sc_time ArbiterExtension::getTimeOfGeneration() const
-{
-    return timeOfGeneration;
-}
-
-const ArbiterExtension& ArbiterExtension::getExtension(const tlm::tlm_generic_payload& trans)
-{
-    return *trans.get_extension<ArbiterExtension>();
-}
-
-Thread ArbiterExtension::getThread(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ArbiterExtension>()->thread;
-}
-
-Channel ArbiterExtension::getChannel(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ArbiterExtension>()->channel;
-}
-
-uint64_t ArbiterExtension::getThreadPayloadID(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ArbiterExtension>()->threadPayloadID;
-}
-
-sc_time ArbiterExtension::getTimeOfGeneration(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ArbiterExtension>()->timeOfGeneration;
+    priority = cpyFrom.priority;
+    deadline = cpyFrom.deadline;
 }
 
 ControllerExtension::ControllerExtension(uint64_t channelPayloadID,
@@ -192,6 +165,7 @@ void ControllerExtension::setAutoExtension(tlm::tlm_generic_payload& trans,
         extension->row = row;
         extension->column = column;
         extension->burstLength = burstLength;
+        extension->forwarded = false;
     }
     else
     {
@@ -218,8 +192,10 @@ void ControllerExtension::setExtension(tlm::tlm_generic_payload& trans,
 
 tlm_extension_base* ControllerExtension::clone() const
 {
-    return new ControllerExtension(
-        channelPayloadID, rank, bankGroup, bank, row, column, burstLength);
+    auto* extension =
+        new ControllerExtension(channelPayloadID, rank, bankGroup, bank, row, column, burstLength);
+    extension->forwarded = forwarded;
+    return extension;
 }
 
 void ControllerExtension::copy_from(const tlm_extension_base& ext)
@@ -232,81 +208,7 @@ void ControllerExtension::copy_from(const tlm_extension_base& ext)
     row = cpyFrom.row;
     column = cpyFrom.column;
     burstLength = cpyFrom.burstLength;
-}
-
-uint64_t ControllerExtension::getChannelPayloadID() const
-{
-    return channelPayloadID;
-}
-
-Rank ControllerExtension::getRank() const
-{
-    return rank;
-}
-
-BankGroup ControllerExtension::getBankGroup() const
-{
-    return bankGroup;
-}
-
-Bank ControllerExtension::getBank() const
-{
-    return bank;
-}
-
-Row ControllerExtension::getRow() const
-{
-    return row;
-}
-
-Column ControllerExtension::getColumn() const
-{
-    return column;
-}
-
-unsigned ControllerExtension::getBurstLength() const
-{
-    return burstLength;
-}
-
-const ControllerExtension& ControllerExtension::getExtension(const tlm::tlm_generic_payload& trans)
-{
-    return *trans.get_extension<ControllerExtension>();
-}
-
-uint64_t ControllerExtension::getChannelPayloadID(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ControllerExtension>()->channelPayloadID;
-}
-
-Rank ControllerExtension::getRank(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ControllerExtension>()->rank;
-}
-
-BankGroup ControllerExtension::getBankGroup(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ControllerExtension>()->bankGroup;
-}
-
-Bank ControllerExtension::getBank(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ControllerExtension>()->bank;
-}
-
-Row ControllerExtension::getRow(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ControllerExtension>()->row;
-}
-
-Column ControllerExtension::getColumn(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ControllerExtension>()->column;
-}
-
-unsigned ControllerExtension::getBurstLength(const tlm::tlm_generic_payload& trans)
-{
-    return trans.get_extension<ControllerExtension>()->burstLength;
+    forwarded = cpyFrom.forwarded;
 }
 
 tlm::tlm_extension_base* ChildExtension::clone() const
@@ -353,46 +255,58 @@ bool ChildExtension::isChildTrans(const tlm::tlm_generic_payload& trans)
 
 tlm_extension_base* ParentExtension::clone() const
 {
-    return new ParentExtension(childTranses);
+    auto* extension = new ParentExtension;
+    extension->copy_from(*this);
+    return extension;
 }
 
 void ParentExtension::copy_from(const tlm_extension_base& ext)
 {
     const auto& cpyFrom = dynamic_cast<const ParentExtension&>(ext);
-    childTranses = cpyFrom.childTranses;
+    inlineChildTranses = cpyFrom.inlineChildTranses;
+    overflowChildTranses = cpyFrom.overflowChildTranses;
+    numberOfChildTranses = cpyFrom.numberOfChildTranses;
+    completedChildTranses = cpyFrom.completedChildTranses;
 }
 
-void ParentExtension::setExtension(tlm::tlm_generic_payload& parentTrans,
-                                   std::vector<tlm::tlm_generic_payload*> childTranses)
+void ParentExtension::addChildTrans(tlm::tlm_generic_payload& childTrans)
 {
-    auto* extension = parentTrans.get_extension<ParentExtension>();
-
-    if (extension != nullptr)
+    if (numberOfChildTranses < INLINE_CHILD_TRANSES)
     {
-        extension->childTranses = std::move(childTranses);
-        extension->completedChildTranses = 0;
+        inlineChildTranses[numberOfChildTranses] = &childTrans;
     }
     else
     {
-        extension = new ParentExtension(std::move(childTranses));
-        parentTrans.set_auto_extension(extension);
+        if (numberOfChildTranses == INLINE_CHILD_TRANSES)
+            overflowChildTranses.assign(inlineChildTranses.cbegin(), inlineChildTranses.cend());
+
+        overflowChildTranses.push_back(&childTrans);
     }
+
+    numberOfChildTranses++;
 }
 
-const std::vector<tlm::tlm_generic_payload*>& ParentExtension::getChildTranses()
+tlm::tlm_generic_payload* const* ParentExtension::childTransData() const
 {
-    return childTranses;
+    return numberOfChildTranses <= INLINE_CHILD_TRANSES ? inlineChildTranses.data()
+                                                         : overflowChildTranses.data();
+}
+
+ParentExtension::ChildTranses ParentExtension::getChildTranses() const
+{
+    return {childTransData(), childTransData() + numberOfChildTranses};
 }
 
 bool ParentExtension::notifyChildTransCompletion()
 {
     completedChildTranses++;
-    if (completedChildTranses == childTranses.size())
+    if (completedChildTranses == numberOfChildTranses)
     {
-        std::for_each(childTranses.begin(),
-                      childTranses.end(),
-                      [](tlm::tlm_generic_payload* childTrans) { childTrans->release(); });
-        childTranses.clear();
+        for (auto* childTrans : getChildTranses())
+            childTrans->release();
+
+        numberOfChildTranses = 0;
+        completedChildTranses = 0;
         return true;
     }
 
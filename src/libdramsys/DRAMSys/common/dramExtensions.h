@@ -37,6 +37,7 @@
 #ifndef DRAMEXTENSIONS_H
 #define DRAMEXTENSIONS_H
 
+#include <array>
 #include <iostream>
 #include <vector>
 
@@ -90,20 +91,48 @@ public:
     static void setIDAndTimeOfGeneration(tlm::tlm_generic_payload& trans,
                                          uint64_t threadPayloadID,
                                          const sc_core::sc_time& timeOfGeneration);
+    static void setQoS(tlm::tlm_generic_payload& trans,
+                       unsigned int priority,
+                       const sc_core::sc_time& deadline);
 
     [[nodiscard]] tlm::tlm_extension_base* clone() const override;
     void copy_from(const tlm::tlm_extension_base& ext) override;
 
-    [[nodiscard]] Thread getThread() const;
-    [[nodiscard]] Channel getChannel() const;
-    [[nodiscard]] uint64_t getThreadPayloadID() const;
-    [[nodiscard]] sc_core::sc_time getTimeOfGeneration() const;
+    [[nodiscard]] Thread getThread() const { return thread; }
+    [[nodiscard]] Channel getChannel() const { return channel; }
+    [[nodiscard]] uint64_t getThreadPayloadID() const { return threadPayloadID; }
+    [[nodiscard]] sc_core::sc_time getTimeOfGeneration() const { return timeOfGeneration; }
+    [[nodiscard]] unsigned int getPriority() const { return priority; }
+    [[nodiscard]] sc_core::sc_time getDeadline() const { return deadline; }
 
-    static const ArbiterExtension& getExtension(const tlm::tlm_generic_payload& trans);
-    static Thread getThread(const tlm::tlm_generic_payload& trans);
-    static Channel getChannel(const tlm::tlm_generic_payload& trans);
-    static uint64_t getThreadPayloadID(const tlm::tlm_generic_payload& trans);
-    static sc_core::sc_time getTimeOfGeneration(const tlm::tlm_generic_payload& trans);
+    static const ArbiterExtension& getExtension(const tlm::tlm_generic_payload& trans)
+    {
+        return *trans.get_extension<ArbiterExtension>();
+    }
+    static Thread getThread(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ArbiterExtension>()->thread;
+    }
+    static Channel getChannel(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ArbiterExtension>()->channel;
+    }
+    static uint64_t getThreadPayloadID(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ArbiterExtension>()->threadPayloadID;
+    }
+    static sc_core::sc_time getTimeOfGeneration(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ArbiterExtension>()->timeOfGeneration;
+    }
+    static unsigned int getPriority(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ArbiterExtension>()->priority;
+    }
+    static sc_core::sc_time getDeadline(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ArbiterExtension>()->deadline;
+    }
 
 private:
     ArbiterExtension(Thread thread,
@@ -114,6 +143,11 @@ private:
     Channel channel;
     uint64_t threadPayloadID;
     sc_core::sc_time timeOfGeneration;
+
+    // Quality of service hints of the initiator: a higher priority is more important, the deadline
+    // is the absolute time by which the response should be returned.
+    unsigned int priority = 0;
+    sc_core::sc_time deadline = sc_core::sc_max_time();
 };
 
 class ControllerExtension : public tlm::tlm_extension<ControllerExtension>
@@ -142,22 +176,57 @@ public:
     [[nodiscard]] tlm::tlm_extension_base* clone() const override;
     void copy_from(const tlm::tlm_extension_base& ext) override;
 
-    [[nodiscard]] uint64_t getChannelPayloadID() const;
-    [[nodiscard]] Rank getRank() const;
-    [[nodiscard]] BankGroup getBankGroup() const;
-    [[nodiscard]] Bank getBank() const;
-    [[nodiscard]] Row getRow() const;
-    [[nodiscard]] Column getColumn() const;
-    [[nodiscard]] unsigned getBurstLength() const;
-
-    static const ControllerExtension& getExtension(const tlm::tlm_generic_payload& trans);
-    static uint64_t getChannelPayloadID(const tlm::tlm_generic_payload& trans);
-    static Rank getRank(const tlm::tlm_generic_payload& trans);
-    static BankGroup getBankGroup(const tlm::tlm_generic_payload& trans);
-    static Bank getBank(const tlm::tlm_generic_payload& trans);
-    static Row getRow(const tlm::tlm_generic_payload& trans);
-    static Column getColumn(const tlm::tlm_generic_payload& trans);
-    static unsigned getBurstLength(const tlm::tlm_generic_payload& trans);
+    [[nodiscard]] uint64_t getChannelPayloadID() const { return channelPayloadID; }
+    [[nodiscard]] Rank getRank() const { return rank; }
+    [[nodiscard]] BankGroup getBankGroup() const { return bankGroup; }
+    [[nodiscard]] Bank getBank() const { return bank; }
+    [[nodiscard]] Row getRow() const { return row; }
+    [[nodiscard]] Column getColumn() const { return column; }
+    [[nodiscard]] unsigned getBurstLength() const { return burstLength; }
+    [[nodiscard]] bool isForwarded() const { return forwarded; }
+
+    static const ControllerExtension& getExtension(const tlm::tlm_generic_payload& trans)
+    {
+        return *trans.get_extension<ControllerExtension>();
+    }
+    static uint64_t getChannelPayloadID(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ControllerExtension>()->channelPayloadID;
+    }
+    static Rank getRank(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ControllerExtension>()->rank;
+    }
+    static BankGroup getBankGroup(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ControllerExtension>()->bankGroup;
+    }
+    static Bank getBank(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ControllerExtension>()->bank;
+    }
+    static Row getRow(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ControllerExtension>()->row;
+    }
+    static Column getColumn(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ControllerExtension>()->column;
+    }
+    static unsigned getBurstLength(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ControllerExtension>()->burstLength;
+    }
+    static bool isForwarded(const tlm::tlm_generic_payload& trans)
+    {
+        return trans.get_extension<ControllerExtension>()->forwarded;
+    }
+
+    // Marks a read that is served by a pending write without accessing the memory
+    static void setForwarded(tlm::tlm_generic_payload& trans)
+    {
+        trans.get_extension<ControllerExtension>()->forwarded = true;
+    }
 
 private:
     ControllerExtension(uint64_t channelPayloadID,
@@ -174,6 +243,7 @@ private:
     Row row;
     Column column;
     unsigned burstLength;
+    bool forwarded = false;
 };
 
 class ChildExtension : public tlm::tlm_extension<ChildExtension>
@@ -196,24 +266,35 @@ public:
 
 class ParentExtension : public tlm::tlm_extension<ParentExtension>
 {
-private:
-    std::vector<tlm::tlm_generic_payload*> childTranses;
-    unsigned completedChildTranses = 0;
-    explicit ParentExtension(std::vector<tlm::tlm_generic_payload*> _childTranses) :
-        childTranses(std::move(_childTranses))
+public:
+    // Contiguous view on the child transactions
+    struct ChildTranses
     {
-    }
+        tlm::tlm_generic_payload* const* first;
+        tlm::tlm_generic_payload* const* last;
 
-public:
-    ParentExtension() = delete;
+        [[nodiscard]] tlm::tlm_generic_payload* const* begin() const { return first; }
+        [[nodiscard]] tlm::tlm_generic_payload* const* end() const { return last; }
+    };
 
     [[nodiscard]] tlm_extension_base* clone() const override;
     void copy_from(const tlm_extension_base& ext) override;
-    static void setExtension(tlm::tlm_generic_payload& parentTrans,
-                             std::vector<tlm::tlm_generic_payload*> childTranses);
-    const std::vector<tlm::tlm_generic_payload*>& getChildTranses();
+    void addChildTrans(tlm::tlm_generic_payload& childTrans);
+    [[nodiscard]] ChildTranses getChildTranses() const;
     bool notifyChildTransCompletion();
     static bool notifyChildTransCompletion(tlm::tlm_generic_payload& trans);
+
+private:
+    // The child transactions of typical requests fit into the inline array. Only larger
+    // requests move them to the overflow vector, which keeps its capacity when the extension is
+    // reused.
+    static constexpr unsigned INLINE_CHILD_TRANSES = 8;
+    std::array<tlm::tlm_generic_payload*, INLINE_CHILD_TRANSES> inlineChildTranses{};
+    std::vector<tlm::tlm_generic_payload*> overflowChildTranses;
+    unsigned numberOfChildTranses = 0;
+    unsigned completedChildTranses = 0;
+
+    [[nodiscard]] tlm::tlm_generic_payload* const* childTransData() const;
 };
 
 class EccExtension : public tlm::tlm_extension<EccExtension>
@@ -34,6 +34,8 @@
 
 #include "BankMachine.h"
 
+#include "DRAMSys/common/Checkpoint.h"
+
 #include <algorithm>
 
 using namespace sc_core;
@@ -182,6 +184,17 @@ bool BankMachine::isPrecharged() const
     return state == State::Precharged;
 }
 
+void BankMachine::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream, state, openRow, blocked, sleeping, refreshManagementCounter);
+}
+
+void BankMachine::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream, state, openRow, blocked, sleeping, refreshManagementCounter);
+    nextCommand = Command::NOP;
+}
+
 BankMachineOpen::BankMachineOpen(const McConfig& config,
                                  const MemSpec& memSpec,
                                  const SchedulerIF& scheduler,
@@ -406,4 +419,153 @@ void BankMachineClosedAdaptive::evaluate()
     }
 }
 
+BankMachinePredictive::BankMachinePredictive(const McConfig& config,
+                                             const MemSpec& memSpec,
+                                             const SchedulerIF& scheduler,
+                                             Bank bank) :
+    BankMachine(config, memSpec, scheduler, bank),
+    counters(config.predictorTableSize, COUNTER_THRESHOLD)
+{
+}
+
+void BankMachinePredictive::evaluate()
+{
+    nextCommand = Command::NOP;
+
+    if (!(sleeping || blocked))
+    {
+        tlm_generic_payload* newPayload = scheduler.getNextRequest(*this);
+        if (newPayload == nullptr)
+            return;
+
+        if (outcomePending && !keepTrans)
+            resolvePrediction(ControllerExtension::getRow(*newPayload));
+
+        assert(!keepTrans || currentPayload != nullptr);
+        if (keepTrans)
+        {
+            if (ControllerExtension::getRow(*newPayload) == openRow)
+                currentPayload = newPayload;
+        }
+        else
+        {
+            currentPayload = newPayload;
+        }
+
+        if (state == State::Precharged) // bank precharged
+            nextCommand = Command::ACT;
+        else if (state == State::Activated)
+        {
+            if (ControllerExtension::getRow(*currentPayload) == openRow) // row hit
+            {
+                bool keepRowOpen = false;
+                predicted = false;
+
+                if (scheduler.hasFurtherRowHit(bank, openRow, currentPayload->get_command()))
+                    keepRowOpen = true;
+                else if (!scheduler.hasFurtherRequest(bank, currentPayload->get_command()))
+                {
+                    predicted = true;
+                    predictedRowHit = getCounter(openRow) >= COUNTER_THRESHOLD;
+                    keepRowOpen = predictedRowHit;
+                }
+
+                assert(currentPayload->is_read() || currentPayload->is_write());
+                if (currentPayload->is_read())
+                    nextCommand = keepRowOpen ? Command::RD : Command::RDA;
+                else if (memSpec.requiresMaskedWrite(*currentPayload))
+                    nextCommand = keepRowOpen ? Command::MWR : Command::MWRA;
+                else
+                    nextCommand = keepRowOpen ? Command::WR : Command::WRA;
+            }
+            else // row miss
+                nextCommand = Command::PREPB;
+        }
+    }
+}
+
+void BankMachinePredictive::update(Command command)
+{
+    if (command.isCasCommand())
+    {
+        outcomePending = true;
+        outcomePredicted = predicted;
+        outcomePredictedRowHit = predictedRowHit;
+        lastCasRow = ControllerExtension::getRow(*currentPayload);
+        predicted = false;
+    }
+
+    BankMachine::update(command);
+}
+
+void BankMachinePredictive::resolvePrediction(Row nextRow)
+{
+    // All accesses train the predictor, but only the accesses that followed a predicted decision
+    // count for the accuracy
+    bool rowHit = nextRow == lastCasRow;
+    uint8_t& counter = getCounter(lastCasRow);
+    if (rowHit && counter < COUNTER_MAX)
+        counter++;
+    else if (!rowHit && counter > 0)
+        counter--;
+
+    if (outcomePredicted)
+    {
+        numberOfPredictions++;
+        if (outcomePredictedRowHit == rowHit)
+            numberOfCorrectPredictions++;
+    }
+
+    outcomePending = false;
+}
+
+uint8_t& BankMachinePredictive::getCounter(Row row)
+{
+    return counters[static_cast<std::size_t>(row) % counters.size()];
+}
+
+uint64_t BankMachinePredictive::getNumberOfPredictions() const
+{
+    return numberOfPredictions;
+}
+
+uint64_t BankMachinePredictive::getNumberOfCorrectPredictions() const
+{
+    return numberOfCorrectPredictions;
+}
+
+void BankMachinePredictive::serialize(std::ostream& stream) const
+{
+    BankMachine::serialize(stream);
+    Checkpoint::write(stream,
+                      counters,
+                      predicted,
+                      predictedRowHit,
+                      outcomePending,
+                      outcomePredicted,
+                      outcomePredictedRowHit,
+                      lastCasRow);
+}
+
+void BankMachinePredictive::deserialize(std::istream& stream)
+{
+    BankMachine::deserialize(stream);
+
+    // Checkpoints of other page policies end after the common state, the predictor stays untrained
+    if (!stream || stream.peek() == std::istream::traits_type::eof())
+    {
+        stream.clear(stream.rdstate() & ~std::ios::eofbit);
+        return;
+    }
+
+    Checkpoint::read(stream,
+                     counters,
+                     predicted,
+                     predictedRowHit,
+                     outcomePending,
+                     outcomePredicted,
+                     outcomePredictedRowHit,
+                     lastCasRow);
+}
+
 } // namespace DRAMSys
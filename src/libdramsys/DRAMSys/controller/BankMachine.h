@@ -65,6 +65,11 @@ public:
     [[nodiscard]] bool isPrecharged() const;
     [[nodiscard]] uint64_t getRefreshManagementCounter() const;
 
+    // The state of an idle bank machine does not depend on the page policy, so it can be
+    // restored into bank machines of any policy. Policies with additional state append it.
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+
 protected:
     enum class State
     {
@@ -115,6 +120,43 @@ public:
     void evaluate() override;
 };
 
+// Like OpenAdaptive as long as the scheduler has further requests for the bank. Without further
+// requests, a table of saturating counters indexed by the row predicts whether the next request
+// will hit the same row and the row is kept open or closed with an auto-precharge accordingly.
+class BankMachinePredictive final : public BankMachine
+{
+public:
+    BankMachinePredictive(const McConfig& config, const MemSpec& memSpec, const SchedulerIF& scheduler, Bank bank);
+    void evaluate() override;
+    void update(Command command) override;
+
+    [[nodiscard]] uint64_t getNumberOfPredictions() const;
+    [[nodiscard]] uint64_t getNumberOfCorrectPredictions() const;
+
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+
+private:
+    static constexpr uint8_t COUNTER_MAX = 3;
+    static constexpr uint8_t COUNTER_THRESHOLD = 2;
+
+    void resolvePrediction(Row nextRow);
+    uint8_t& getCounter(Row row);
+
+    std::vector<uint8_t> counters;
+
+    bool predicted = false;
+    bool predictedRowHit = false;
+
+    bool outcomePending = false;
+    bool outcomePredicted = false;
+    bool outcomePredictedRowHit = false;
+    Row lastCasRow = Row(0);
+
+    uint64_t numberOfPredictions = 0;
+    uint64_t numberOfCorrectPredictions = 0;
+};
+
 } // namespace DRAMSys
 
 #endif // BANKMACHINE_H
@@ -36,6 +36,7 @@
 
 #include "Controller.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/dramExtensions.h"
 #include "DRAMSys/config/McConfig.h"
 #include "DRAMSys/controller/checker/CheckerDDR3.h"
@@ -62,6 +63,7 @@
 #include "DRAMSys/controller/scheduler/SchedulerFifo.h"
 #include "DRAMSys/controller/scheduler/SchedulerFrFcfs.h"
 #include "DRAMSys/controller/scheduler/SchedulerFrFcfsGrp.h"
+#include "DRAMSys/controller/scheduler/SchedulerFrFcfsQoS.h"
 #include "DRAMSys/controller/scheduler/SchedulerGrpFrFcfs.h"
 #include "DRAMSys/controller/scheduler/SchedulerGrpFrFcfsWm.h"
 
@@ -75,6 +77,9 @@
 #include "DRAMSys/controller/checker/CheckerHBM3.h"
 #endif
 
+#include <cstring>
+#include <sstream>
+
 using namespace sc_core;
 using namespace tlm;
 
@@ -187,6 +192,8 @@ Controller::Controller(const sc_module_name& name,
         scheduler = std::make_unique<SchedulerGrpFrFcfs>(config, memSpec);
     else if (config.scheduler == Config::SchedulerType::GrpFrFcfsWm)
         scheduler = std::make_unique<SchedulerGrpFrFcfsWm>(config, memSpec);
+    else if (config.scheduler == Config::SchedulerType::FrFcfsQoS)
+        scheduler = std::make_unique<SchedulerFrFcfsQoS>(config, memSpec);
 
     if (config.cmdMux == Config::CmdMuxType::Oldest)
     {
@@ -233,6 +240,12 @@ Controller::Controller(const sc_module_name& name,
             bankMachines.push_back(std::make_unique<BankMachineClosedAdaptive>(
                 config, memSpec, *scheduler, Bank(bankID)));
     }
+    else if (config.pagePolicy == Config::PagePolicyType::Predictive)
+    {
+        for (unsigned bankID = 0; bankID < memSpec.banksPerChannel; bankID++)
+            bankMachines.push_back(std::make_unique<BankMachinePredictive>(
+                config, memSpec, *scheduler, Bank(bankID)));
+    }
 
     bankMachinesOnRank = ControllerVector<Rank, ControllerVector<Bank, BankMachine*>>(
         memSpec.ranksPerChannel, ControllerVector<Bank, BankMachine*>(memSpec.banksPerRank));
@@ -323,6 +336,85 @@ void Controller::registerIdleCallback(std::function<void()> idleCallback)
     this->idleCallback = std::move(idleCallback);
 }
 
+// Checkpoint sections are tagged with the configured type of the component, which does not depend
+// on the compiler like the names of std::type_info
+template <typename Type> static std::string sectionTag(const std::string& component, Type type)
+{
+    return component + ":" + nlohmann::json(type).get<std::string>();
+}
+
+void Controller::serialize(std::ostream& stream) const
+{
+    if (!idle())
+        SC_REPORT_FATAL(name(), "Checkpoints can only be taken while the controller is idle");
+
+    Checkpoint::write(stream, static_cast<uint64_t>(memSpec.banksPerChannel));
+    // Each bank machine is framed because page policies may append their own state
+    for (const auto& bankMachine : bankMachines)
+    {
+        std::ostringstream bankMachineState;
+        bankMachine->serialize(bankMachineState);
+        Checkpoint::writeBlock(stream, bankMachineState.str());
+    }
+
+    Checkpoint::writeSection(stream, sectionTag("Checker", memSpec.memoryType), *checker);
+    Checkpoint::writeSection(stream, sectionTag("Scheduler", config.scheduler), *scheduler);
+
+    for (const auto& refreshManager : refreshManagers)
+    {
+        Checkpoint::writeSection(
+            stream, sectionTag("RefreshManager", config.refreshPolicy), *refreshManager);
+    }
+
+    for (const auto& powerDownManager : powerDownManagers)
+    {
+        Checkpoint::writeSection(
+            stream, sectionTag("PowerDownManager", config.powerDownPolicy), *powerDownManager);
+    }
+}
+
+void Controller::deserialize(std::istream& stream)
+{
+    if (!idle())
+        SC_REPORT_FATAL(name(), "Checkpoints can only be restored while the controller is idle");
+
+    uint64_t numberOfBanks = 0;
+    Checkpoint::read(stream, numberOfBanks);
+    if (numberOfBanks != memSpec.banksPerChannel)
+        SC_REPORT_FATAL(name(), "Checkpoint was taken with a different number of banks");
+
+    for (auto& bankMachine : bankMachines)
+    {
+        std::istringstream bankMachineState(Checkpoint::readBlock(stream));
+        if (!stream)
+            SC_REPORT_FATAL(name(), "Unexpected end of checkpoint");
+
+        bankMachine->deserialize(bankMachineState);
+        if (!bankMachineState)
+            SC_REPORT_FATAL(name(),
+                            "Checkpoint of the bank machines does not match the configuration");
+    }
+
+    Checkpoint::readSection(stream, sectionTag("Checker", memSpec.memoryType), *checker);
+    Checkpoint::readSection(stream, sectionTag("Scheduler", config.scheduler), *scheduler);
+
+    for (auto& refreshManager : refreshManagers)
+    {
+        Checkpoint::readSection(
+            stream, sectionTag("RefreshManager", config.refreshPolicy), *refreshManager);
+    }
+
+    for (auto& powerDownManager : powerDownManagers)
+    {
+        Checkpoint::readSection(
+            stream, sectionTag("PowerDownManager", config.powerDownPolicy), *powerDownManager);
+    }
+
+    // Let the controller act on the restored state
+    if (sc_is_running())
+        controllerEvent.notify(SC_ZERO_TIME);
+}
+
 void Controller::controllerMethod()
 {
     if (isFullCycle(sc_time_stamp(), memSpec.tCK))
@@ -385,8 +477,9 @@ void Controller::controllerMethod()
         tlm_generic_payload* trans = std::get<CommandTuple::Payload>(commandTuple);
         if (command != Command::NOP) // can happen with FIFO strict
         {
-            Rank rank = ControllerExtension::getRank(*trans);
-            Bank bank = ControllerExtension::getBank(*trans);
+            const ControllerExtension& extension = ControllerExtension::getExtension(*trans);
+            Rank rank = extension.getRank();
+            Bank bank = extension.getBank();
 
             if (command.isRankCommand())
             {
@@ -525,6 +618,14 @@ tlm_sync_enum Controller::nb_transport_bw([[maybe_unused]] tlm_generic_payload&
 
 void Controller::b_transport(tlm_generic_payload& trans, sc_time& delay)
 {
+    static bool printedWarning = false;
+
+    if (!functional && !printedWarning)
+    {
+        SC_REPORT_WARNING("Controller", BLOCKING_WARNING.data());
+        printedWarning = true;
+    }
+
     iSocket->b_transport(trans, delay);
     delay += trans.is_write() ? config.blockingWriteDelay : config.blockingReadDelay;
 }
@@ -541,10 +642,11 @@ void Controller::manageRequests(const sc_time& delay)
         // TODO: here we assume that the scheduler always has space not only for a single burst
         // transaction
         //  but for a maximum size transaction
-        if (scheduler->hasBufferSpace())
+        if (functional || scheduler->hasBufferSpace())
         {
             if (totalNumberOfPayloads == 0)
                 idleTimeCollector.end();
+            updatePayloadResidenceTime();
             totalNumberOfPayloads++; // seems to be ok
 
             transToAcquire.payload->acquire();
@@ -554,13 +656,17 @@ void Controller::manageRequests(const sc_time& delay)
                 transToAcquire.payload->get_address() & ~(minBytesPerBurst - UINT64_C(1));
             transToAcquire.payload->set_address(alignedAddress);
 
+            if (functional)
+            {
+                serveFunctionalRequest(*transToAcquire.payload);
+            }
             // continuous block of data that can be fetched with a single burst
-            if ((alignedAddress / maxBytesPerBurst) ==
+            else if ((alignedAddress / maxBytesPerBurst) ==
                 ((alignedAddress + transToAcquire.payload->get_data_length() - 1) /
                  maxBytesPerBurst))
             {
                 DecodedAddress decodedAddress =
-                    addressDecoder.decodeAddress(transToAcquire.payload->get_address());
+                    addressDecoder.decodeAddress(*transToAcquire.payload);
                 ControllerExtension::setAutoExtension(*transToAcquire.payload,
                                                       nextChannelPayloadIDToAppend++,
                                                       Rank(decodedAddress.rank),
@@ -571,19 +677,31 @@ void Controller::manageRequests(const sc_time& delay)
                                                       transToAcquire.payload->get_data_length() /
                                                           memSpec.bytesPerBeat);
 
-                Rank rank = Rank(decodedAddress.rank);
-                if (ranksNumberOfPayloads[rank] == 0)
-                    powerDownManagers[rank]->triggerExit();
-                ranksNumberOfPayloads[rank]++;
+                tlm_generic_payload* forwardingWrite =
+                    transToAcquire.payload->is_read()
+                        ? scheduler->getForwardingWrite(*transToAcquire.payload)
+                        : nullptr;
+
+                if (forwardingWrite != nullptr)
+                {
+                    forwardRequest(*transToAcquire.payload, *forwardingWrite);
+                }
+                else
+                {
+                    Rank rank = Rank(decodedAddress.rank);
+                    if (ranksNumberOfPayloads[rank] == 0)
+                        powerDownManagers[rank]->triggerExit();
+                    ranksNumberOfPayloads[rank]++;
 
-                scheduler->storeRequest(*transToAcquire.payload);
-                Bank bank = Bank(decodedAddress.bank);
-                bankMachines[bank]->evaluate();
+                    scheduler->storeRequest(*transToAcquire.payload);
+                    Bank bank = Bank(decodedAddress.bank);
+                    bankMachines[bank]->evaluate();
+                }
             }
             else
             {
                 createChildTranses(*transToAcquire.payload);
-                const std::vector<tlm_generic_payload*>& childTranses =
+                auto childTranses =
                     transToAcquire.payload->get_extension<ParentExtension>()->getChildTranses();
                 for (auto* childTrans : childTranses)
                 {
@@ -611,6 +729,60 @@ void Controller::manageRequests(const sc_time& delay)
     }
 }
 
+void Controller::updatePayloadResidenceTime()
+{
+    payloadResidenceTime += totalNumberOfPayloads * (sc_time_stamp() - lastResidenceUpdate);
+    lastResidenceUpdate = sc_time_stamp();
+}
+
+sc_time Controller::getPayloadResidenceTime() const
+{
+    return payloadResidenceTime + totalNumberOfPayloads * (sc_time_stamp() - lastResidenceUpdate);
+}
+
+void Controller::setFunctional(bool functional)
+{
+    this->functional = functional;
+}
+
+void Controller::serveFunctionalRequest(tlm_generic_payload& trans)
+{
+    DecodedAddress decodedAddress = addressDecoder.decodeAddress(trans);
+    ControllerExtension::setAutoExtension(trans,
+                                          nextChannelPayloadIDToAppend++,
+                                          Rank(decodedAddress.rank),
+                                          BankGroup(decodedAddress.bankgroup),
+                                          Bank(decodedAddress.bank),
+                                          Row(decodedAddress.row),
+                                          Column(decodedAddress.column),
+                                          trans.get_data_length() / memSpec.bytesPerBeat);
+
+    // The storage is accessed right away, the response follows after the fixed blocking delay
+    sc_time latency = SC_ZERO_TIME;
+    iSocket->b_transport(trans, latency);
+    latency += trans.is_write() ? config.blockingWriteDelay : config.blockingReadDelay;
+
+    respQueue->insertPayload(&trans, sc_time_stamp() + latency);
+    dataResponseEvent.notify(latency);
+}
+
+void Controller::forwardRequest(tlm_generic_payload& read, const tlm_generic_payload& write)
+{
+    // The read is served with the data of a pending write without accessing the memory
+    if (read.get_data_ptr() != nullptr && write.get_data_ptr() != nullptr)
+    {
+        std::memcpy(read.get_data_ptr(),
+                    write.get_data_ptr() + (read.get_address() - write.get_address()),
+                    read.get_data_length());
+    }
+    read.set_response_status(TLM_OK_RESPONSE);
+    ControllerExtension::setForwarded(read);
+
+    sc_time latency = config.thinkDelayFw + memSpec.tCK + config.thinkDelayBw;
+    respQueue->insertPayload(&read, sc_time_stamp() + latency);
+    dataResponseEvent.notify(latency);
+}
+
 void Controller::manageResponses()
 {
     if (transToRelease.payload != nullptr)
@@ -618,9 +790,12 @@ void Controller::manageResponses()
         assert(transToRelease.arrival >= sc_time_stamp());
         if (transToRelease.arrival == sc_time_stamp()) // END_RESP completed
         {
+            memoryManager.freeParentExtension(*transToRelease.payload);
             transToRelease.payload->release();
             transToRelease.payload = nullptr;
+            updatePayloadResidenceTime();
             totalNumberOfPayloads--;
+            numberOfPayloadsServed++;
 
             if (totalNumberOfPayloads == 0)
             {
@@ -639,8 +814,9 @@ void Controller::manageResponses()
     tlm_generic_payload* nextTransInRespQueue = respQueue->nextPayload();
     if (nextTransInRespQueue != nullptr)
     {
-        // Ignore ECC requests
-        if (nextTransInRespQueue->get_extension<EccExtension>() == nullptr)
+        // Ignore ECC requests and reads forwarded from pending writes
+        if (nextTransInRespQueue->get_extension<EccExtension>() == nullptr &&
+            !ControllerExtension::isForwarded(*nextTransInRespQueue))
             numberOfBeatsServed += ControllerExtension::getBurstLength(*nextTransInRespQueue);
 
         if (ChildExtension::isChildTrans(*nextTransInRespQueue))
@@ -698,13 +874,14 @@ void Controller::sendToFrontend(tlm_generic_payload& trans, tlm_phase& phase, sc
 
 Controller::MemoryManager::~MemoryManager()
 {
-    while (!freePayloads.empty())
+    for (tlm_generic_payload* trans : freePayloads)
     {
-        tlm_generic_payload* trans = freePayloads.top();
-        freePayloads.pop();
         trans->reset();
         delete trans;
     }
+
+    for (ParentExtension* extension : freeParentExtensions)
+        delete extension;
 }
 
 tlm::tlm_generic_payload& Controller::MemoryManager::allocate()
@@ -714,19 +891,43 @@ tlm::tlm_generic_payload& Controller::MemoryManager::allocate()
         return *new tlm_generic_payload(this);
     }
 
-    tlm_generic_payload* result = freePayloads.top();
-    freePayloads.pop();
+    tlm_generic_payload* result = freePayloads.back();
+    freePayloads.pop_back();
     return *result;
 }
 
 void Controller::MemoryManager::free(tlm::tlm_generic_payload* trans)
 {
-    freePayloads.push(trans);
+    freePayloads.push_back(trans);
+}
+
+ParentExtension& Controller::MemoryManager::allocateParentExtension()
+{
+    if (freeParentExtensions.empty())
+    {
+        return *new ParentExtension;
+    }
+
+    ParentExtension* result = freeParentExtensions.back();
+    freeParentExtensions.pop_back();
+    return *result;
+}
+
+void Controller::MemoryManager::freeParentExtension(tlm::tlm_generic_payload& parentTrans)
+{
+    auto* extension = parentTrans.get_extension<ParentExtension>();
+
+    if (extension != nullptr)
+    {
+        parentTrans.clear_extension(extension);
+        freeParentExtensions.push_back(extension);
+    }
 }
 
 void Controller::createChildTranses(tlm::tlm_generic_payload& parentTrans)
 {
-    std::vector<tlm_generic_payload*> childTranses;
+    ParentExtension& parentExtension = memoryManager.allocateParentExtension();
+    parentTrans.set_extension(&parentExtension);
 
     uint64_t startAddress = parentTrans.get_address() & ~(maxBytesPerBurst - UINT64_C(1));
     unsigned char* startDataPtr = parentTrans.get_data_ptr();
@@ -741,12 +942,12 @@ void Controller::createChildTranses(tlm::tlm_generic_payload& parentTrans)
         childTrans.set_data_length(maxBytesPerBurst);
         childTrans.set_data_ptr(startDataPtr + childId * maxBytesPerBurst);
         ChildExtension::setExtension(childTrans, parentTrans);
-        childTranses.push_back(&childTrans);
+        parentExtension.addChildTrans(childTrans);
     }
 
     if (startAddress != parentTrans.get_address())
     {
-        tlm_generic_payload& firstChildTrans = *childTranses.front();
+        tlm_generic_payload& firstChildTrans = **parentExtension.getChildTranses().begin();
         firstChildTrans.set_address(firstChildTrans.get_address() + minBytesPerBurst);
         firstChildTrans.set_data_ptr(firstChildTrans.get_data_ptr() + minBytesPerBurst);
         firstChildTrans.set_data_length(minBytesPerBurst);
@@ -757,10 +958,10 @@ void Controller::createChildTranses(tlm::tlm_generic_payload& parentTrans)
         lastChildTrans.set_data_length(minBytesPerBurst);
         lastChildTrans.set_data_ptr(startDataPtr + numChildTranses * maxBytesPerBurst);
         ChildExtension::setExtension(lastChildTrans, parentTrans);
-        childTranses.push_back(&lastChildTrans);
+        parentExtension.addChildTrans(lastChildTrans);
     }
 
-    for (auto* childTrans : childTranses)
+    for (auto* childTrans : parentExtension.getChildTranses())
     {
         DecodedAddress decodedAddress = addressDecoder.decodeAddress(childTrans->get_address());
         ControllerExtension::setAutoExtension(*childTrans,
@@ -773,7 +974,6 @@ void Controller::createChildTranses(tlm::tlm_generic_payload& parentTrans)
                                               childTrans->get_data_length() / memSpec.bytesPerBeat);
     }
     nextChannelPayloadIDToAppend++;
-    ParentExtension::setExtension(parentTrans, std::move(childTranses));
 }
 
 void Controller::end_of_simulation()
@@ -812,6 +1012,26 @@ void Controller::end_of_simulation()
     std::cout << name() << std::string("  MAX BW:         ") << std::fixed << std::setprecision(2)
               << std::setw(6) << maxBandwidth << " Gb/s | " << std::setw(6) << maxBandwidth / 8
               << " GB/s | " << std::setw(6) << 100.0 << " %" << std::endl;
+
+    if (config.pagePolicy == Config::PagePolicyType::Predictive)
+    {
+        uint64_t numberOfPredictions = 0;
+        uint64_t numberOfCorrectPredictions = 0;
+        for (const auto& bankMachine : bankMachines)
+        {
+            const auto& predictive = dynamic_cast<const BankMachinePredictive&>(*bankMachine);
+            numberOfPredictions += predictive.getNumberOfPredictions();
+            numberOfCorrectPredictions += predictive.getNumberOfCorrectPredictions();
+        }
+
+        double accuracy = numberOfPredictions == 0
+                              ? 0.0
+                              : static_cast<double>(numberOfCorrectPredictions) /
+                                    static_cast<double>(numberOfPredictions);
+        std::cout << name() << std::string("  PAGE PREDICTOR: ") << numberOfCorrectPredictions
+                  << " / " << numberOfPredictions << " correct | " << std::fixed
+                  << std::setprecision(2) << std::setw(6) << (accuracy * 100) << " %" << std::endl;
+    }
 }
 
 } // namespace DRAMSys
@@ -47,10 +47,12 @@
 #include "respqueue/RespQueueIF.h"
 
 #include <DRAMSys/common/DebugManager.h>
+#include <DRAMSys/common/Deserialize.h>
+#include <DRAMSys/common/Serialize.h>
 #include <DRAMSys/simulation/AddressDecoder.h>
 
 #include <functional>
-#include <stack>
+#include <string_view>
 #include <systemc>
 #include <tlm>
 #include <tlm_utils/simple_initiator_socket.h>
@@ -61,7 +63,7 @@
 namespace DRAMSys
 {
 
-class Controller : public sc_core::sc_module
+class Controller : public sc_core::sc_module, public Serialize, public Deserialize
 {
 public:
     tlm_utils::simple_target_socket<Controller> tSocket{"tSocket"};    // Arbiter side
@@ -76,6 +78,28 @@ public:
     [[nodiscard]] bool idle() const { return totalNumberOfPayloads == 0; }
     void registerIdleCallback(std::function<void()> idleCallback);
 
+    // In functional mode requests bypass the scheduler and the timing checker. They access the
+    // storage immediately and are answered after the fixed blocking read/write delay. Requests
+    // that are already scheduled complete normally after a switch.
+    void setFunctional(bool functional);
+    [[nodiscard]] bool isFunctional() const { return functional; }
+
+    // Cumulative statistics, the difference of two readings covers the time in between. The
+    // residence time is the integral of the number of outstanding payloads, so by Little's law
+    // it divided by the number of served payloads is their average latency.
+    [[nodiscard]] uint64_t getNumberOfBeatsServed() const { return numberOfBeatsServed; }
+    [[nodiscard]] uint64_t getNumberOfPayloadsServed() const { return numberOfPayloadsServed; }
+    [[nodiscard]] sc_core::sc_time getPayloadResidenceTime() const;
+
+    static constexpr std::string_view BLOCKING_WARNING =
+        "Use the blocking mode of DRAMSys with caution! "
+        "The simulated timings do not reflect the real system!";
+
+    // Only the state of an idle controller can be checkpointed. Statistics are not part of a
+    // checkpoint, so they only cover the simulation after a restore.
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+
 protected:
     void end_of_simulation() override;
 
@@ -102,7 +126,11 @@ protected:
     sc_core::sc_time scMaxTime = sc_core::sc_max_time();
 
     uint64_t numberOfBeatsServed = 0;
+    uint64_t numberOfPayloadsServed = 0;
     unsigned totalNumberOfPayloads = 0;
+    sc_core::sc_time payloadResidenceTime = sc_core::SC_ZERO_TIME;
+    sc_core::sc_time lastResidenceUpdate = sc_core::SC_ZERO_TIME;
+    void updatePayloadResidenceTime();
     std::function<void()> idleCallback;
     ControllerVector<Rank, unsigned> ranksNumberOfPayloads;
     ReadyCommands readyCommands;
@@ -132,6 +160,10 @@ protected:
     const unsigned maxBytesPerBurst;
 
     void createChildTranses(tlm::tlm_generic_payload& parentTrans);
+    void serveFunctionalRequest(tlm::tlm_generic_payload& trans);
+    void forwardRequest(tlm::tlm_generic_payload& read, const tlm::tlm_generic_payload& write);
+
+    bool functional = false;
 
     class MemoryManager : public tlm::tlm_mm_interface
     {
@@ -146,8 +178,14 @@ protected:
         tlm::tlm_generic_payload& allocate();
         void free(tlm::tlm_generic_payload* trans) override;
 
+        // Parent extensions are attached to the transactions of the initiators, so they are
+        // detached and recycled by the controller when the parent transaction is released
+        ParentExtension& allocateParentExtension();
+        void freeParentExtension(tlm::tlm_generic_payload& parentTrans);
+
     private:
-        std::stack<tlm::tlm_generic_payload*> freePayloads;
+        std::vector<tlm::tlm_generic_payload*> freePayloads;
+        std::vector<ParentExtension*> freeParentExtensions;
     } memoryManager;
 
     class IdleTimeCollector
@@ -35,12 +35,14 @@
 #ifndef MANAGERIF_H
 #define MANAGERIF_H
 
+#include "DRAMSys/common/Deserialize.h"
+#include "DRAMSys/common/Serialize.h"
 #include "DRAMSys/controller/Command.h"
 
 namespace DRAMSys
 {
 
-class ManagerIF
+class ManagerIF : public Serialize, public Deserialize
 {
 protected:
     ManagerIF(const ManagerIF&) = default;
@@ -40,10 +40,17 @@ namespace DRAMSys
 
 McConfig::McConfig(const Config::McConfig& config, const MemSpec& memSpec) :
     pagePolicy(config.PagePolicy.value_or(DEFAULT_PAGE_POLICY)),
+    predictorTableSize(config.PredictorTableSize.value_or(DEFAULT_PREDICTOR_TABLE_SIZE)),
     scheduler(config.Scheduler.value_or(DEFAULT_SCHEDULER)),
     schedulerBuffer(config.SchedulerBuffer.value_or(DEFAULT_SCHEDULER_BUFFER)),
     lowWatermark(config.LowWatermark.value_or(DEFAULT_LOW_WATERMARK)),
     highWatermark(config.HighWatermark.value_or(DEFAULT_HIGH_WATERMARK)),
+    adaptiveWatermarks(config.AdaptiveWatermarks.value_or(DEFAULT_ADAPTIVE_WATERMARKS)),
+    maxRequestAge(sc_core::sc_time(config.MaxRequestAge.value_or(DEFAULT_MAX_REQUEST_AGE_NS),
+                                   sc_core::SC_NS)),
+    blacklistingThreshold(config.BlacklistingThreshold.value_or(DEFAULT_BLACKLISTING_THRESHOLD)),
+    blacklistingInterval(sc_core::sc_time(
+        config.BlacklistingInterval.value_or(DEFAULT_BLACKLISTING_INTERVAL_NS), sc_core::SC_NS)),
     cmdMux(config.CmdMux.value_or(DEFAULT_CMD_MUX)),
     respQueue(config.RespQueue.value_or(DEFAULT_RESP_QUEUE)),
     arbiter(config.Arbiter.value_or(DEFAULT_ARBITER)),
@@ -86,6 +93,9 @@ McConfig::McConfig(const Config::McConfig& config, const MemSpec& memSpec) :
     if (pagePolicy == Config::PagePolicyType::Invalid)
         SC_REPORT_FATAL("McConfig", "Invalid PagePolicy");
 
+    if (pagePolicy == Config::PagePolicyType::Predictive && predictorTableSize == 0)
+        SC_REPORT_FATAL("McConfig", "PredictorTableSize must be greater than zero");
+
     if (scheduler == Config::SchedulerType::Invalid)
         SC_REPORT_FATAL("McConfig", "Invalid Scheduler");
 
@@ -116,6 +126,9 @@ McConfig::McConfig(const Config::McConfig& config, const MemSpec& memSpec) :
     if (requestBufferSizeWrite < 1)
         SC_REPORT_FATAL("Configuration", "Minimum request buffer size is 1!");
 
+    if (blacklistingThreshold != 0 && blacklistingInterval < memSpec.tCK)
+        SC_REPORT_FATAL("Configuration", "Blacklisting interval must be at least one clock cycle!");
+
     arbitrationDelayFw = std::round(arbitrationDelayFw / memSpec.tCK) * memSpec.tCK;
     arbitrationDelayBw = std::round(arbitrationDelayBw / memSpec.tCK) * memSpec.tCK;
 
@@ -127,6 +140,9 @@ McConfig::McConfig(const Config::McConfig& config, const MemSpec& memSpec) :
 
     blockingReadDelay = std::round(blockingReadDelay / memSpec.tCK) * memSpec.tCK;
     blockingWriteDelay = std::round(blockingWriteDelay / memSpec.tCK) * memSpec.tCK;
+
+    maxRequestAge = std::round(maxRequestAge / memSpec.tCK) * memSpec.tCK;
+    blacklistingInterval = std::round(blacklistingInterval / memSpec.tCK) * memSpec.tCK;
 }
 
 } // namespace DRAMSys
@@ -49,11 +49,17 @@ struct McConfig
     McConfig(const Config::McConfig& config, const MemSpec& memSpec);
 
     Config::PagePolicyType pagePolicy;
+    unsigned int predictorTableSize;
     Config::SchedulerType scheduler;
     Config::SchedulerBufferType schedulerBuffer;
 
     unsigned int lowWatermark;
     unsigned int highWatermark;
+    bool adaptiveWatermarks;
+
+    sc_core::sc_time maxRequestAge;
+    unsigned int blacklistingThreshold;
+    sc_core::sc_time blacklistingInterval;
 
     Config::CmdMuxType cmdMux;
     Config::RespQueueType respQueue;
@@ -81,11 +87,16 @@ struct McConfig
     sc_core::sc_time blockingWriteDelay;
 
     static constexpr Config::PagePolicyType DEFAULT_PAGE_POLICY = Config::PagePolicyType::Open;
+    static constexpr unsigned int DEFAULT_PREDICTOR_TABLE_SIZE = 64;
     static constexpr Config::SchedulerType DEFAULT_SCHEDULER = Config::SchedulerType::FrFcfs;
     static constexpr Config::SchedulerBufferType DEFAULT_SCHEDULER_BUFFER =
         Config::SchedulerBufferType::Bankwise;
     static constexpr unsigned int DEFAULT_LOW_WATERMARK = 0;
     static constexpr unsigned int DEFAULT_HIGH_WATERMARK = 0;
+    static constexpr bool DEFAULT_ADAPTIVE_WATERMARKS = false;
+    static constexpr unsigned DEFAULT_MAX_REQUEST_AGE_NS = 1000;
+    static constexpr unsigned int DEFAULT_BLACKLISTING_THRESHOLD = 4;
+    static constexpr unsigned DEFAULT_BLACKLISTING_INTERVAL_NS = 10000;
     static constexpr Config::CmdMuxType DEFAULT_CMD_MUX = Config::CmdMuxType::Oldest;
     static constexpr Config::RespQueueType DEFAULT_RESP_QUEUE = Config::RespQueueType::Fifo;
     static constexpr Config::ArbiterType DEFAULT_ARBITER = Config::ArbiterType::Simple;
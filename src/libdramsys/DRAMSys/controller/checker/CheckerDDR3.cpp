@@ -34,6 +34,7 @@
 
 #include "CheckerDDR3.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 
 #include <algorithm>
@@ -71,8 +72,9 @@ CheckerDDR3::CheckerDDR3(const MemSpecDDR3& memSpec) :
 sc_time CheckerDDR3::timeToSatisfyConstraints(Command command,
                                               const tlm_generic_payload& payload) const
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    Bank bank = extension.getBank();
 
     sc_time lastCommandStart;
     sc_time earliestTimeToStart = sc_time_stamp();
@@ -474,8 +476,9 @@ sc_time CheckerDDR3::timeToSatisfyConstraints(Command command,
 
 void CheckerDDR3::insert(Command command, const tlm_generic_payload& payload)
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    Bank bank = extension.getBank();
 
     // Hack: Convert MWR to WR and MWRA to WRA
     if (command == Command::MWR)
@@ -501,4 +504,24 @@ void CheckerDDR3::insert(Command command, const tlm_generic_payload& payload)
     }
 }
 
+void CheckerDDR3::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      lastScheduledByCommandAndBank,
+                      lastScheduledByCommandAndRank,
+                      lastScheduledByCommand,
+                      lastCommandOnBus,
+                      last4Activates);
+}
+
+void CheckerDDR3::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream,
+                     lastScheduledByCommandAndBank,
+                     lastScheduledByCommandAndRank,
+                     lastScheduledByCommand,
+                     lastCommandOnBus,
+                     last4Activates);
+}
+
 } // namespace DRAMSys
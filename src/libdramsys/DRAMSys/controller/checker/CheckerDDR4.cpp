@@ -34,6 +34,7 @@
 
 #include "CheckerDDR4.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 #include "DRAMSys/configuration/memspec/MemSpecDDR4.h"
 
@@ -76,9 +77,10 @@ CheckerDDR4::CheckerDDR4(const MemSpecDDR4 &memSpec) :
 sc_time CheckerDDR4::timeToSatisfyConstraints(Command command,
                                               const tlm_generic_payload& payload) const
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    BankGroup bankGroup = ControllerExtension::getBankGroup(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    BankGroup bankGroup = extension.getBankGroup();
+    Bank bank = extension.getBank();
 
     sc_time lastCommandStart;
     sc_time earliestTimeToStart = sc_time_stamp();
@@ -508,9 +510,10 @@ sc_time CheckerDDR4::timeToSatisfyConstraints(Command command,
 
 void CheckerDDR4::insert(Command command, const tlm_generic_payload& payload)
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    BankGroup bankGroup = ControllerExtension::getBankGroup(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    BankGroup bankGroup = extension.getBankGroup();
+    Bank bank = extension.getBank();
 
     // Hack: Convert MWR to WR and MWRA to WRA
     if (command == Command::MWR)
@@ -536,4 +539,26 @@ void CheckerDDR4::insert(Command command, const tlm_generic_payload& payload)
     }
 }
 
+void CheckerDDR4::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      lastScheduledByCommandAndBank,
+                      lastScheduledByCommandAndBankGroup,
+                      lastScheduledByCommandAndRank,
+                      lastScheduledByCommand,
+                      lastCommandOnBus,
+                      last4Activates);
+}
+
+void CheckerDDR4::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream,
+                     lastScheduledByCommandAndBank,
+                     lastScheduledByCommandAndBankGroup,
+                     lastScheduledByCommandAndRank,
+                     lastScheduledByCommand,
+                     lastCommandOnBus,
+                     last4Activates);
+}
+
 } // namespace DRAMSys
@@ -34,6 +34,7 @@
 
 #include "CheckerGDDR5.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 #include "DRAMSys/configuration/memspec/MemSpecGDDR5.h"
 
@@ -77,9 +78,10 @@ CheckerGDDR5::CheckerGDDR5(const MemSpecGDDR5& memSpec) :
 sc_time CheckerGDDR5::timeToSatisfyConstraints(Command command,
                                                const tlm_generic_payload& payload) const
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    BankGroup bankGroup = ControllerExtension::getBankGroup(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    BankGroup bankGroup = extension.getBankGroup();
+    Bank bank = extension.getBank();
 
     sc_time lastCommandStart;
     sc_time earliestTimeToStart = sc_time_stamp();
@@ -590,9 +592,10 @@ sc_time CheckerGDDR5::timeToSatisfyConstraints(Command command,
 
 void CheckerGDDR5::insert(Command command, const tlm_generic_payload& payload)
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    BankGroup bankGroup = ControllerExtension::getBankGroup(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    BankGroup bankGroup = extension.getBankGroup();
+    Bank bank = extension.getBank();
 
     PRINTDEBUGMESSAGE("CheckerGDDR5",
                       "Changing state on bank " + std::to_string(static_cast<std::size_t>(bank)) +
@@ -619,4 +622,30 @@ void CheckerGDDR5::insert(Command command, const tlm_generic_payload& payload)
         bankwiseRefreshCounter[rank] = (bankwiseRefreshCounter[rank] + 1) % memSpec.banksPerRank;
 }
 
+void CheckerGDDR5::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      lastScheduledByCommandAndBank,
+                      lastScheduledByCommandAndBankGroup,
+                      lastScheduledByCommandAndRank,
+                      lastScheduledByCommand,
+                      lastCommandOnBus,
+                      last4Activates,
+                      last32Activates,
+                      bankwiseRefreshCounter);
+}
+
+void CheckerGDDR5::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream,
+                     lastScheduledByCommandAndBank,
+                     lastScheduledByCommandAndBankGroup,
+                     lastScheduledByCommandAndRank,
+                     lastScheduledByCommand,
+                     lastCommandOnBus,
+                     last4Activates,
+                     last32Activates,
+                     bankwiseRefreshCounter);
+}
+
 } // namespace DRAMSys
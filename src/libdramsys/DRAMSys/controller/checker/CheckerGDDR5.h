@@ -53,6 +53,9 @@ public:
                              const tlm::tlm_generic_payload& payload) const override;
     void insert(Command command, const tlm::tlm_generic_payload& payload) override;
 
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+
 private:
     const MemSpecGDDR5& memSpec;
 
@@ -34,6 +34,7 @@
 
 #include "CheckerGDDR5X.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 
 #include <algorithm>
@@ -76,9 +77,10 @@ CheckerGDDR5X::CheckerGDDR5X(const MemSpecGDDR5X& memSpec) :
 sc_time CheckerGDDR5X::timeToSatisfyConstraints(Command command,
                                                 const tlm_generic_payload& payload) const
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    BankGroup bankGroup = ControllerExtension::getBankGroup(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    BankGroup bankGroup = extension.getBankGroup();
+    Bank bank = extension.getBank();
 
     sc_time lastCommandStart;
     sc_time earliestTimeToStart = sc_time_stamp();
@@ -593,9 +595,10 @@ sc_time CheckerGDDR5X::timeToSatisfyConstraints(Command command,
 
 void CheckerGDDR5X::insert(Command command, const tlm_generic_payload& payload)
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    BankGroup bankGroup = ControllerExtension::getBankGroup(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    BankGroup bankGroup = extension.getBankGroup();
+    Bank bank = extension.getBank();
 
     PRINTDEBUGMESSAGE("CheckerGDDR5X",
                       "Changing state on bank " + std::to_string(static_cast<std::size_t>(bank)) +
@@ -622,4 +625,30 @@ void CheckerGDDR5X::insert(Command command, const tlm_generic_payload& payload)
         bankwiseRefreshCounter[rank] = (bankwiseRefreshCounter[rank] + 1) % memSpec.banksPerRank;
 }
 
+void CheckerGDDR5X::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      lastScheduledByCommandAndBank,
+                      lastScheduledByCommandAndBankGroup,
+                      lastScheduledByCommandAndRank,
+                      lastScheduledByCommand,
+                      lastCommandOnBus,
+                      last4Activates,
+                      last32Activates,
+                      bankwiseRefreshCounter);
+}
+
+void CheckerGDDR5X::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream,
+                     lastScheduledByCommandAndBank,
+                     lastScheduledByCommandAndBankGroup,
+                     lastScheduledByCommandAndRank,
+                     lastScheduledByCommand,
+                     lastCommandOnBus,
+                     last4Activates,
+                     last32Activates,
+                     bankwiseRefreshCounter);
+}
+
 } // namespace DRAMSys
@@ -34,6 +34,7 @@
 
 #include "CheckerGDDR6.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 
 #include <algorithm>
@@ -75,9 +76,10 @@ CheckerGDDR6::CheckerGDDR6(const MemSpecGDDR6& memSpec) :
 sc_time CheckerGDDR6::timeToSatisfyConstraints(Command command,
                                                const tlm_generic_payload& payload) const
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    BankGroup bankGroup = ControllerExtension::getBankGroup(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    BankGroup bankGroup = extension.getBankGroup();
+    Bank bank = extension.getBank();
 
     sc_time lastCommandStart;
     sc_time earliestTimeToStart = sc_time_stamp();
@@ -615,9 +617,10 @@ sc_time CheckerGDDR6::timeToSatisfyConstraints(Command command,
 
 void CheckerGDDR6::insert(Command command, const tlm_generic_payload& payload)
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    BankGroup bankGroup = ControllerExtension::getBankGroup(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    BankGroup bankGroup = extension.getBankGroup();
+    Bank bank = extension.getBank();
 
     PRINTDEBUGMESSAGE("CheckerGDDR6",
                       "Changing state on bank " + std::to_string(static_cast<std::size_t>(bank)) +
@@ -640,4 +643,28 @@ void CheckerGDDR6::insert(Command command, const tlm_generic_payload& payload)
         bankwiseRefreshCounter[rank] = (bankwiseRefreshCounter[rank] + 1) % memSpec.banksPerRank;
 }
 
+void CheckerGDDR6::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      lastScheduledByCommandAndBank,
+                      lastScheduledByCommandAndBankGroup,
+                      lastScheduledByCommandAndRank,
+                      lastScheduledByCommand,
+                      lastCommandOnBus,
+                      last4Activates,
+                      bankwiseRefreshCounter);
+}
+
+void CheckerGDDR6::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream,
+                     lastScheduledByCommandAndBank,
+                     lastScheduledByCommandAndBankGroup,
+                     lastScheduledByCommandAndRank,
+                     lastScheduledByCommand,
+                     lastCommandOnBus,
+                     last4Activates,
+                     bankwiseRefreshCounter);
+}
+
 } // namespace DRAMSys
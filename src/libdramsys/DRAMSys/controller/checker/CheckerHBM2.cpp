@@ -34,6 +34,7 @@
 
 #include "CheckerHBM2.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 #include "DRAMSys/configuration/memspec/MemSpecHBM2.h"
 
@@ -77,9 +78,10 @@ CheckerHBM2::CheckerHBM2(const MemSpecHBM2& memSpec) :
 sc_time CheckerHBM2::timeToSatisfyConstraints(Command command,
                                               const tlm_generic_payload& payload) const
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    BankGroup bankGroup = ControllerExtension::getBankGroup(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    BankGroup bankGroup = extension.getBankGroup();
+    Bank bank = extension.getBank();
 
     sc_time lastCommandStart;
     sc_time earliestTimeToStart = sc_time_stamp();
@@ -534,9 +536,10 @@ sc_time CheckerHBM2::timeToSatisfyConstraints(Command command,
 
 void CheckerHBM2::insert(Command command, const tlm_generic_payload& payload)
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    BankGroup bankGroup = ControllerExtension::getBankGroup(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    BankGroup bankGroup = extension.getBankGroup();
+    Bank bank = extension.getBank();
 
     // Hack: Convert MWR to WR and MWRA to WRA
     if (command == Command::MWR)
@@ -571,4 +574,30 @@ void CheckerHBM2::insert(Command command, const tlm_generic_payload& payload)
         bankwiseRefreshCounter[rank] = (bankwiseRefreshCounter[rank] + 1) % memSpec.banksPerRank;
 }
 
+void CheckerHBM2::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      lastScheduledByCommandAndBank,
+                      lastScheduledByCommandAndBankGroup,
+                      lastScheduledByCommandAndRank,
+                      lastScheduledByCommand,
+                      lastCommandOnRasBus,
+                      lastCommandOnCasBus,
+                      last4Activates,
+                      bankwiseRefreshCounter);
+}
+
+void CheckerHBM2::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream,
+                     lastScheduledByCommandAndBank,
+                     lastScheduledByCommandAndBankGroup,
+                     lastScheduledByCommandAndRank,
+                     lastScheduledByCommand,
+                     lastCommandOnRasBus,
+                     lastCommandOnCasBus,
+                     last4Activates,
+                     bankwiseRefreshCounter);
+}
+
 } // namespace DRAMSys
@@ -35,6 +35,8 @@
 #ifndef CHECKERIF_H
 #define CHECKERIF_H
 
+#include "DRAMSys/common/Deserialize.h"
+#include "DRAMSys/common/Serialize.h"
 #include "DRAMSys/controller/Command.h"
 
 #include <systemc>
@@ -42,7 +44,7 @@
 namespace DRAMSys
 {
 
-class CheckerIF
+class CheckerIF : public Serialize, public Deserialize
 {
 protected:
     CheckerIF(const CheckerIF&) = default;
@@ -34,6 +34,7 @@
 
 #include "CheckerLPDDR4.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 
 #include <algorithm>
@@ -89,8 +90,9 @@ CheckerLPDDR4::CheckerLPDDR4(const MemSpecLPDDR4& memSpec) :
 sc_time CheckerLPDDR4::timeToSatisfyConstraints(Command command,
                                                 const tlm_generic_payload& payload) const
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    Bank bank = extension.getBank();
 
     sc_time lastCommandStart;
     sc_time earliestTimeToStart = sc_time_stamp();
@@ -606,8 +608,9 @@ sc_time CheckerLPDDR4::timeToSatisfyConstraints(Command command,
 
 void CheckerLPDDR4::insert(Command command, const tlm_generic_payload& payload)
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    Bank bank = extension.getBank();
 
     // Hack: Convert MWR to WR and MWRA to WRA
     if (command == Command::MWR)
@@ -639,4 +642,26 @@ void CheckerLPDDR4::insert(Command command, const tlm_generic_payload& payload)
     }
 }
 
+void CheckerLPDDR4::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      lastScheduledByCommandAndBank,
+                      lastScheduledByCommandAndRank,
+                      lastScheduledByCommand,
+                      lastCommandOnBus,
+                      lastBurstLengthByCommandAndBank,
+                      last4Activates);
+}
+
+void CheckerLPDDR4::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream,
+                     lastScheduledByCommandAndBank,
+                     lastScheduledByCommandAndRank,
+                     lastScheduledByCommand,
+                     lastCommandOnBus,
+                     lastBurstLengthByCommandAndBank,
+                     last4Activates);
+}
+
 } // namespace DRAMSys
@@ -34,6 +34,7 @@
 
 #include "CheckerWideIO.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 
 #include <algorithm>
@@ -71,8 +72,9 @@ CheckerWideIO::CheckerWideIO(const MemSpecWideIO& memSpec) :
 sc_time CheckerWideIO::timeToSatisfyConstraints(Command command,
                                                 const tlm_generic_payload& payload) const
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    Bank bank = extension.getBank();
 
     sc_time lastCommandStart;
     sc_time earliestTimeToStart = sc_time_stamp();
@@ -444,8 +446,9 @@ sc_time CheckerWideIO::timeToSatisfyConstraints(Command command,
 
 void CheckerWideIO::insert(Command command, const tlm_generic_payload& payload)
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    Bank bank = extension.getBank();
 
     // Hack: Convert MWR to WR and MWRA to WRA
     if (command == Command::MWR)
@@ -470,4 +473,24 @@ void CheckerWideIO::insert(Command command, const tlm_generic_payload& payload)
     }
 }
 
+void CheckerWideIO::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      lastScheduledByCommandAndBank,
+                      lastScheduledByCommandAndRank,
+                      lastScheduledByCommand,
+                      lastCommandOnBus,
+                      last2Activates);
+}
+
+void CheckerWideIO::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream,
+                     lastScheduledByCommandAndBank,
+                     lastScheduledByCommandAndRank,
+                     lastScheduledByCommand,
+                     lastCommandOnBus,
+                     last2Activates);
+}
+
 } // namespace DRAMSys
@@ -34,6 +34,7 @@
 
 #include "CheckerWideIO2.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 
 #include <algorithm>
@@ -72,8 +73,9 @@ CheckerWideIO2::CheckerWideIO2(const MemSpecWideIO2& memSpec) :
 sc_time CheckerWideIO2::timeToSatisfyConstraints(Command command,
                                                  const tlm_generic_payload& payload) const
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    Bank bank = extension.getBank();
 
     sc_time lastCommandStart;
     sc_time earliestTimeToStart = sc_time_stamp();
@@ -528,8 +530,9 @@ sc_time CheckerWideIO2::timeToSatisfyConstraints(Command command,
 
 void CheckerWideIO2::insert(Command command, const tlm_generic_payload& payload)
 {
-    Rank rank = ControllerExtension::getRank(payload);
-    Bank bank = ControllerExtension::getBank(payload);
+    const ControllerExtension& extension = ControllerExtension::getExtension(payload);
+    Rank rank = extension.getRank();
+    Bank bank = extension.getBank();
 
     // Hack: Convert MWR to WR and MWRA to WRA
     if (command == Command::MWR)
@@ -554,4 +557,24 @@ void CheckerWideIO2::insert(Command command, const tlm_generic_payload& payload)
     }
 }
 
+void CheckerWideIO2::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      lastScheduledByCommandAndBank,
+                      lastScheduledByCommandAndRank,
+                      lastScheduledByCommand,
+                      lastCommandOnBus,
+                      last4Activates);
+}
+
+void CheckerWideIO2::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream,
+                     lastScheduledByCommandAndBank,
+                     lastScheduledByCommandAndRank,
+                     lastScheduledByCommand,
+                     lastCommandOnBus,
+                     last4Activates);
+}
+
 } // namespace DRAMSys
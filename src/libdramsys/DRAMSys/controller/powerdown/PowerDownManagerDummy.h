@@ -52,6 +52,9 @@ public:
     CommandTuple::Type getNextCommand() override;
     void update([[maybe_unused]] Command command) override {}
     void evaluate() override {}
+
+    void serialize([[maybe_unused]] std::ostream& stream) const override {}
+    void deserialize([[maybe_unused]] std::istream& stream) override {}
 };
 
 } // namespace DRAMSys
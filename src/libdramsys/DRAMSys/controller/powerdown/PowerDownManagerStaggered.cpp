@@ -34,6 +34,7 @@
 
 #include "PowerDownManagerStaggered.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/controller/BankMachine.h"
 
 using namespace sc_core;
@@ -163,4 +164,17 @@ void PowerDownManagerStaggered::update(Command command)
     }
 }
 
+void PowerDownManagerStaggered::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(
+        stream, state, controllerIdle, entryTriggered, exitTriggered, enterSelfRefresh);
+}
+
+void PowerDownManagerStaggered::deserialize(std::istream& stream)
+{
+    Checkpoint::read(
+        stream, state, controllerIdle, entryTriggered, exitTriggered, enterSelfRefresh);
+    nextCommand = Command::NOP;
+}
+
 } // namespace DRAMSys
@@ -59,6 +59,9 @@ public:
     void update(Command command) override;
     void evaluate() override;
 
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+
 private:
     enum class State
     {
@@ -240,4 +240,17 @@ sc_time RefreshManagerAllBank::getTimeForNextTrigger()
     return timeForNextTrigger;
 }
 
+void RefreshManagerAllBank::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(
+        stream, state, timeForNextTrigger, activatedBanks, flexibilityCounter, sleeping);
+}
+
+void RefreshManagerAllBank::deserialize(std::istream& stream)
+{
+    Checkpoint::read(
+        stream, state, timeForNextTrigger, activatedBanks, flexibilityCounter, sleeping);
+    nextCommand = Command::NOP;
+}
+
 } // namespace DRAMSys
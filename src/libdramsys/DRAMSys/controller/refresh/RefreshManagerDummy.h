@@ -50,6 +50,9 @@ public:
     void update([[maybe_unused]] Command command) override {}
     sc_core::sc_time getTimeForNextTrigger() override;
 
+    void serialize([[maybe_unused]] std::ostream& stream) const override {}
+    void deserialize([[maybe_unused]] std::istream& stream) override {}
+
 private:
     const sc_core::sc_time scMaxTime = sc_core::sc_max_time();
 };
@@ -35,11 +35,15 @@
 #ifndef REFRESHMANAGERIF_H
 #define REFRESHMANAGERIF_H
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/dramExtensions.h"
 #include "DRAMSys/controller/Command.h"
 #include "DRAMSys/controller/ManagerIF.h"
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <list>
 #include <systemc>
 
 namespace DRAMSys
@@ -81,6 +85,63 @@ protected:
 
         return timeForFirstTrigger;
     }
+
+    // The bank machines that still have to be refreshed are stored by their position in the list
+    // of all bank machines of the rank
+    template <typename Entry>
+    static void serializeRemaining(std::ostream& stream,
+                                   const std::list<Entry>& all,
+                                   const std::list<Entry>& remaining,
+                                   typename std::list<Entry>::const_iterator current)
+    {
+        Checkpoint::write(stream, static_cast<uint64_t>(remaining.size()));
+
+        for (const auto& entry : remaining)
+        {
+            auto position = std::distance(all.begin(), std::find(all.begin(), all.end(), entry));
+            Checkpoint::write(stream, static_cast<uint64_t>(position));
+        }
+
+        auto currentPosition = std::distance(remaining.begin(), current);
+        Checkpoint::write(stream, static_cast<uint64_t>(currentPosition));
+    }
+
+    template <typename Entry>
+    static void deserializeRemaining(std::istream& stream,
+                                     const std::list<Entry>& all,
+                                     std::list<Entry>& remaining,
+                                     typename std::list<Entry>::iterator& current)
+    {
+        uint64_t size = 0;
+        Checkpoint::read(stream, size);
+
+        std::list<Entry> restored;
+        for (uint64_t i = 0; i < size && stream; i++)
+        {
+            uint64_t position = 0;
+            Checkpoint::read(stream, position);
+
+            if (position >= all.size())
+            {
+                stream.setstate(std::ios::failbit);
+                return;
+            }
+
+            restored.push_back(*std::next(all.begin(), static_cast<std::ptrdiff_t>(position)));
+        }
+
+        uint64_t currentPosition = 0;
+        Checkpoint::read(stream, currentPosition);
+
+        if (!stream || restored.empty() || currentPosition > restored.size())
+        {
+            stream.setstate(std::ios::failbit);
+            return;
+        }
+
+        remaining = std::move(restored);
+        current = std::next(remaining.begin(), static_cast<std::ptrdiff_t>(currentPosition));
+    }
 };
 
 } // namespace DRAMSys
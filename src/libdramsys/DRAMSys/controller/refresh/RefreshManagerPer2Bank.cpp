@@ -264,4 +264,19 @@ sc_time RefreshManagerPer2Bank::getTimeForNextTrigger()
     return timeForNextTrigger;
 }
 
+void RefreshManagerPer2Bank::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(
+        stream, state, timeForNextTrigger, flexibilityCounter, sleeping, skipSelection);
+    serializeRemaining(stream, allBankMachines, remainingBankMachines, currentIterator);
+}
+
+void RefreshManagerPer2Bank::deserialize(std::istream& stream)
+{
+    Checkpoint::read(
+        stream, state, timeForNextTrigger, flexibilityCounter, sleeping, skipSelection);
+    deserializeRemaining(stream, allBankMachines, remainingBankMachines, currentIterator);
+    nextCommand = Command::NOP;
+}
+
 } // namespace DRAMSys
@@ -213,4 +213,19 @@ sc_time RefreshManagerPerBank::getTimeForNextTrigger()
     return timeForNextTrigger;
 }
 
+void RefreshManagerPerBank::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(
+        stream, state, timeForNextTrigger, flexibilityCounter, sleeping, skipSelection);
+    serializeRemaining(stream, allBankMachines, remainingBankMachines, currentIterator);
+}
+
+void RefreshManagerPerBank::deserialize(std::istream& stream)
+{
+    Checkpoint::read(
+        stream, state, timeForNextTrigger, flexibilityCounter, sleeping, skipSelection);
+    deserializeRemaining(stream, allBankMachines, remainingBankMachines, currentIterator);
+    nextCommand = Command::NOP;
+}
+
 } // namespace DRAMSys
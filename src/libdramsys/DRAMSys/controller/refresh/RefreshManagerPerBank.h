@@ -66,6 +66,9 @@ public:
     void update(Command command) override;
     sc_core::sc_time getTimeForNextTrigger() override;
 
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+
 private:
     enum class State
     {
@@ -337,4 +337,19 @@ sc_time RefreshManagerSameBank::getTimeForNextTrigger()
     return timeForNextTrigger;
 }
 
+void RefreshManagerSameBank::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(
+        stream, state, timeForNextTrigger, flexibilityCounter, sleeping, skipSelection);
+    serializeRemaining(stream, allBankMachines, remainingBankMachines, currentIterator);
+}
+
+void RefreshManagerSameBank::deserialize(std::istream& stream)
+{
+    Checkpoint::read(
+        stream, state, timeForNextTrigger, flexibilityCounter, sleeping, skipSelection);
+    deserializeRemaining(stream, allBankMachines, remainingBankMachines, currentIterator);
+    nextCommand = Command::NOP;
+}
+
 } // namespace DRAMSys
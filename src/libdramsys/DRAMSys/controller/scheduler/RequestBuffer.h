@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef REQUESTBUFFER_H
+#define REQUESTBUFFER_H
+
+#include "DRAMSys/common/dramExtensions.h"
+
+#include <algorithm>
+#include <tlm>
+#include <vector>
+
+namespace DRAMSys
+{
+
+// Buffered requests of one bank in arrival order. The row of every request is stored in a dense
+// array next to the payload pointers when the request is buffered. The searches for row hits,
+// which run for every bank machine in every cycle, then scan consecutive rows instead of looking
+// up the ControllerExtension of each payload.
+class RequestBuffer
+{
+public:
+    void push_back(tlm::tlm_generic_payload& payload)
+    {
+        payloads.push_back(&payload);
+        rows.push_back(ControllerExtension::getRow(payload));
+    }
+
+    void remove(const tlm::tlm_generic_payload& payload)
+    {
+        auto it = std::find(payloads.begin(), payloads.end(), &payload);
+        if (it == payloads.end())
+            return;
+
+        rows.erase(rows.begin() + (it - payloads.begin()));
+        payloads.erase(it);
+    }
+
+    [[nodiscard]] bool empty() const { return payloads.empty(); }
+    [[nodiscard]] std::size_t size() const { return payloads.size(); }
+    [[nodiscard]] tlm::tlm_generic_payload* front() const { return payloads.front(); }
+
+    [[nodiscard]] const std::vector<tlm::tlm_generic_payload*>& getPayloads() const
+    {
+        return payloads;
+    }
+    [[nodiscard]] const std::vector<Row>& getRows() const { return rows; }
+
+    // Returns the oldest request to the row or nullptr
+    [[nodiscard]] tlm::tlm_generic_payload* findRowHit(Row row) const
+    {
+        auto it = std::find(rows.begin(), rows.end(), row);
+        return it != rows.end() ? payloads[it - rows.begin()] : nullptr;
+    }
+
+    // Returns true if at least two requests target the row
+    [[nodiscard]] bool hasFurtherRowHit(Row row) const
+    {
+        auto it = std::find(rows.begin(), rows.end(), row);
+        return it != rows.end() && std::find(it + 1, rows.end(), row) != rows.end();
+    }
+
+private:
+    std::vector<tlm::tlm_generic_payload*> payloads;
+    std::vector<Row> rows;
+};
+
+} // namespace DRAMSys
+
+#endif // REQUESTBUFFER_H
@@ -63,6 +63,9 @@ public:
     [[nodiscard]] bool hasFurtherRequest(Bank bank, tlm::tlm_command command) const override;
     [[nodiscard]] const std::vector<unsigned>& getBufferDepth() const override;
 
+    void serialize([[maybe_unused]] std::ostream& stream) const override {}
+    void deserialize([[maybe_unused]] std::istream& stream) override {}
+
 private:
     ControllerVector<Bank, std::deque<tlm::tlm_generic_payload*>> buffer;
     std::unique_ptr<BufferCounterIF> bufferCounter;
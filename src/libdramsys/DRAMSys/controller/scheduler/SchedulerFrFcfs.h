@@ -39,9 +39,9 @@
 #include "DRAMSys/controller/BankMachine.h"
 #include "DRAMSys/controller/McConfig.h"
 #include "DRAMSys/controller/scheduler/BufferCounterIF.h"
+#include "DRAMSys/controller/scheduler/RequestBuffer.h"
 #include "DRAMSys/controller/scheduler/SchedulerIF.h"
 
-#include <list>
 #include <memory>
 #include <tlm>
 #include <vector>
@@ -63,8 +63,11 @@ public:
     [[nodiscard]] bool hasFurtherRequest(Bank bank, tlm::tlm_command command) const override;
     [[nodiscard]] const std::vector<unsigned>& getBufferDepth() const override;
 
+    void serialize([[maybe_unused]] std::ostream& stream) const override {}
+    void deserialize([[maybe_unused]] std::istream& stream) override {}
+
 private:
-    ControllerVector<Bank, std::list<tlm::tlm_generic_payload*>> buffer;
+    ControllerVector<Bank, RequestBuffer> buffer;
     std::unique_ptr<BufferCounterIF> bufferCounter;
 };
 
@@ -34,6 +34,7 @@
 
 #include "SchedulerFrFcfsGrp.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/controller/scheduler/BufferCounterBankwise.h"
 #include "DRAMSys/controller/scheduler/BufferCounterReadWrite.h"
 #include "DRAMSys/controller/scheduler/BufferCounterShared.h"
@@ -45,7 +46,7 @@ namespace DRAMSys
 
 SchedulerFrFcfsGrp::SchedulerFrFcfsGrp(const McConfig& config, const MemSpec& memSpec)
 {
-    buffer = ControllerVector<Bank, std::list<tlm_generic_payload*>>(memSpec.banksPerChannel);
+    buffer = ControllerVector<Bank, RequestBuffer>(memSpec.banksPerChannel);
 
     if (config.schedulerBuffer == Config::SchedulerBufferType::Bankwise)
         bufferCounter = std::make_unique<BufferCounterBankwise>(config.requestBufferSize,
@@ -64,7 +65,7 @@ bool SchedulerFrFcfsGrp::hasBufferSpace() const
 
 void SchedulerFrFcfsGrp::storeRequest(tlm_generic_payload& trans)
 {
-    buffer[ControllerExtension::getBank(trans)].push_back(&trans);
+    buffer[ControllerExtension::getBank(trans)].push_back(trans);
     bufferCounter->storeRequest(trans);
 }
 
@@ -72,15 +73,7 @@ void SchedulerFrFcfsGrp::removeRequest(tlm_generic_payload& trans)
 {
     bufferCounter->removeRequest(trans);
     lastCommand = trans.get_command();
-    Bank bank = ControllerExtension::getBank(trans);
-    for (auto it = buffer[bank].begin(); it != buffer[bank].end(); it++)
-    {
-        if (*it == &trans)
-        {
-            buffer[bank].erase(it);
-            break;
-        }
-    }
+    buffer[ControllerExtension::getBank(trans)].remove(trans);
 }
 
 tlm_generic_payload* SchedulerFrFcfsGrp::getNextRequest(const BankMachine& bankMachine) const
@@ -92,11 +85,12 @@ tlm_generic_payload* SchedulerFrFcfsGrp::getNextRequest(const BankMachine& bankM
         {
             // Filter all row hits
             Row openRow = bankMachine.getOpenRow();
+            const std::vector<Row>& rows = buffer[bank].getRows();
             std::list<tlm_generic_payload*> rowHits;
-            for (auto* it : buffer[bank])
+            for (std::size_t index = 0; index < rows.size(); index++)
             {
-                if (ControllerExtension::getRow(*it) == openRow)
-                    rowHits.push_back(it);
+                if (rows[index] == openRow)
+                    rowHits.push_back(buffer[bank].getPayloads()[index]);
             }
 
             if (!rowHits.empty())
@@ -132,17 +126,7 @@ bool SchedulerFrFcfsGrp::hasFurtherRowHit(Bank bank,
                                           Row row,
                                           [[maybe_unused]] tlm_command command) const
 {
-    unsigned rowHitCounter = 0;
-    for (auto* it : buffer[bank])
-    {
-        if (ControllerExtension::getRow(*it) == row)
-        {
-            rowHitCounter++;
-            if (rowHitCounter == 2)
-                return true;
-        }
-    }
-    return false;
+    return buffer[bank].hasFurtherRowHit(row);
 }
 
 bool SchedulerFrFcfsGrp::hasFurtherRequest(Bank bank, [[maybe_unused]] tlm_command command) const
@@ -155,4 +139,14 @@ const std::vector<unsigned>& SchedulerFrFcfsGrp::getBufferDepth() const
     return bufferCounter->getBufferDepth();
 }
 
+void SchedulerFrFcfsGrp::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream, lastCommand);
+}
+
+void SchedulerFrFcfsGrp::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream, lastCommand);
+}
+
 } // namespace DRAMSys
@@ -38,6 +38,7 @@
 #include "DRAMSys/common/dramExtensions.h"
 #include "DRAMSys/controller/BankMachine.h"
 #include "DRAMSys/controller/scheduler/BufferCounterIF.h"
+#include "DRAMSys/controller/scheduler/RequestBuffer.h"
 #include "DRAMSys/controller/scheduler/SchedulerIF.h"
 
 #include <list>
@@ -62,8 +63,11 @@ public:
     [[nodiscard]] bool hasFurtherRequest(Bank bank, tlm::tlm_command command) const override;
     [[nodiscard]] const std::vector<unsigned>& getBufferDepth() const override;
 
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+
 private:
-    ControllerVector<Bank, std::list<tlm::tlm_generic_payload*>> buffer;
+    ControllerVector<Bank, RequestBuffer> buffer;
     tlm::tlm_command lastCommand = tlm::TLM_READ_COMMAND;
     std::unique_ptr<BufferCounterIF> bufferCounter;
 };
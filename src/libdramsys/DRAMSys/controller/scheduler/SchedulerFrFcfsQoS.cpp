@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SchedulerFrFcfsQoS.h"
+
+#include "DRAMSys/common/Checkpoint.h"
+#include "DRAMSys/controller/scheduler/BufferCounterBankwise.h"
+#include "DRAMSys/controller/scheduler/BufferCounterReadWrite.h"
+#include "DRAMSys/controller/scheduler/BufferCounterShared.h"
+
+using namespace sc_core;
+using namespace tlm;
+
+namespace DRAMSys
+{
+
+SchedulerFrFcfsQoS::SchedulerFrFcfsQoS(const McConfig& config, const MemSpec& memSpec) :
+    maxRequestAge(config.maxRequestAge),
+    blacklistingThreshold(config.blacklistingThreshold),
+    blacklistingInterval(config.blacklistingInterval)
+{
+    buffer = ControllerVector<Bank, BankBuffer>(memSpec.banksPerChannel);
+
+    if (config.schedulerBuffer == Config::SchedulerBufferType::Bankwise)
+        bufferCounter = std::make_unique<BufferCounterBankwise>(config.requestBufferSize,
+                                                                memSpec.banksPerChannel);
+    else if (config.schedulerBuffer == Config::SchedulerBufferType::ReadWrite)
+        bufferCounter = std::make_unique<BufferCounterReadWrite>(config.requestBufferSizeRead,
+                                                                 config.requestBufferSizeWrite);
+    else if (config.schedulerBuffer == Config::SchedulerBufferType::Shared)
+        bufferCounter = std::make_unique<BufferCounterShared>(config.requestBufferSize);
+}
+
+bool SchedulerFrFcfsQoS::hasBufferSpace() const
+{
+    return bufferCounter->hasBufferSpace();
+}
+
+void SchedulerFrFcfsQoS::storeRequest(tlm_generic_payload& payload)
+{
+    // Child transactions inherit the quality of service of their parent.
+    tlm_generic_payload& origin =
+        ChildExtension::isChildTrans(payload) ? ChildExtension::getParentTrans(payload) : payload;
+    const auto* arbiterExtension = origin.get_extension<ArbiterExtension>();
+
+    Request request{&payload, std::nullopt, 0, sc_time_stamp(), sc_max_time()};
+    if (arbiterExtension != nullptr)
+    {
+        request.thread = arbiterExtension->getThread();
+        request.priority = arbiterExtension->getPriority();
+        request.deadline = arbiterExtension->getDeadline();
+    }
+
+    uint64_t sequence = nextSequence++;
+    sequenceOfPayload.emplace(&payload, sequence);
+
+    BankBuffer& bankBuffer = buffer[ControllerExtension::getBank(payload)];
+    bankBuffer.byAge.emplace(sequence, request);
+    bankBuffer.byPriority.insert({request.priority, sequence});
+    bankBuffer.byRow[ControllerExtension::getRow(payload)].insert({request.priority, sequence});
+    if (request.deadline != sc_max_time())
+        bankBuffer.byDeadline.emplace(request.deadline, sequence);
+
+    bufferCounter->storeRequest(payload);
+}
+
+void SchedulerFrFcfsQoS::removeRequest(tlm_generic_payload& payload)
+{
+    bufferCounter->removeRequest(payload);
+
+    auto sequenceIt = sequenceOfPayload.find(&payload);
+    uint64_t sequence = sequenceIt->second;
+    sequenceOfPayload.erase(sequenceIt);
+
+    BankBuffer& bankBuffer = buffer[ControllerExtension::getBank(payload)];
+    auto requestIt = bankBuffer.byAge.find(sequence);
+    const Request& request = requestIt->second;
+
+    bankBuffer.byPriority.erase({request.priority, sequence});
+    auto rowIt = bankBuffer.byRow.find(ControllerExtension::getRow(payload));
+    rowIt->second.erase({request.priority, sequence});
+    if (rowIt->second.empty())
+        bankBuffer.byRow.erase(rowIt);
+    if (request.deadline != sc_max_time())
+        bankBuffer.byDeadline.erase({request.deadline, sequence});
+
+    // Blacklist threads that are served too many times in a row.
+    if (blacklistingThreshold != 0 && request.thread.has_value())
+    {
+        if (request.thread == lastServedThread)
+            servedInARow++;
+        else
+        {
+            lastServedThread = request.thread;
+            servedInARow = 1;
+        }
+
+        if (servedInARow >= blacklistingThreshold)
+        {
+            timeOfBlacklisting[*request.thread] = sc_time_stamp();
+            servedInARow = 0;
+        }
+    }
+
+    bankBuffer.byAge.erase(requestIt);
+}
+
+tlm_generic_payload* SchedulerFrFcfsQoS::getNextRequest(const BankMachine& bankMachine) const
+{
+    const BankBuffer& bankBuffer = buffer[bankMachine.getBank()];
+    if (bankBuffer.byAge.empty())
+        return nullptr;
+
+    // Requests that have missed their deadline or exceeded the maximum age are served first.
+    if (!bankBuffer.byDeadline.empty() && bankBuffer.byDeadline.begin()->first <= sc_time_stamp())
+        return bankBuffer.byAge.at(bankBuffer.byDeadline.begin()->second).payload;
+
+    const Request& oldest = bankBuffer.byAge.begin()->second;
+    if (maxRequestAge != SC_ZERO_TIME && sc_time_stamp() - oldest.arrival >= maxRequestAge)
+        return oldest.payload;
+
+    unsigned int priority = bankBuffer.byPriority.begin()->priority;
+    const std::set<PriorityKey>* rowHits = nullptr;
+    if (bankMachine.isActivated())
+    {
+        auto rowIt = bankBuffer.byRow.find(bankMachine.getOpenRow());
+        if (rowIt != bankBuffer.byRow.end())
+            rowHits = &rowIt->second;
+    }
+
+    // Within the highest priority class: row hits of threads that are not blacklisted, other
+    // requests of threads that are not blacklisted, row hits, the oldest request.
+    if (rowHits != nullptr)
+    {
+        if (auto* payload = selectFrom(bankBuffer, *rowHits, priority, true))
+            return payload;
+    }
+
+    if (auto* payload = selectFrom(bankBuffer, bankBuffer.byPriority, priority, true))
+        return payload;
+
+    if (rowHits != nullptr)
+    {
+        if (auto* payload = selectFrom(bankBuffer, *rowHits, priority, false))
+            return payload;
+    }
+
+    return bankBuffer.byAge.at(bankBuffer.byPriority.begin()->sequence).payload;
+}
+
+tlm_generic_payload* SchedulerFrFcfsQoS::selectFrom(const BankBuffer& bankBuffer,
+                                                    const std::set<PriorityKey>& candidates,
+                                                    unsigned int priority,
+                                                    bool skipBlacklisted) const
+{
+    // Only the requests of blacklisted threads are skipped, all others are found in O(log n).
+    for (const PriorityKey& key : candidates)
+    {
+        if (key.priority != priority)
+            break;
+
+        const Request& request = bankBuffer.byAge.at(key.sequence);
+        if (!skipBlacklisted || !isBlacklisted(request.thread))
+            return request.payload;
+    }
+    return nullptr;
+}
+
+bool SchedulerFrFcfsQoS::isBlacklisted(const std::optional<Thread>& thread) const
+{
+    if (!thread.has_value())
+        return false;
+
+    auto it = timeOfBlacklisting.find(*thread);
+    if (it == timeOfBlacklisting.end())
+        return false;
+
+    // The blacklist is cleared at the beginning of every interval.
+    uint64_t interval = blacklistingInterval.value();
+    sc_time startOfInterval =
+        sc_time::from_value(sc_time_stamp().value() / interval * interval);
+    return it->second >= startOfInterval;
+}
+
+bool SchedulerFrFcfsQoS::hasFurtherRowHit(Bank bank,
+                                          Row row,
+                                          [[maybe_unused]] tlm_command command) const
+{
+    auto rowIt = buffer[bank].byRow.find(row);
+    return rowIt != buffer[bank].byRow.end() && rowIt->second.size() >= 2;
+}
+
+bool SchedulerFrFcfsQoS::hasFurtherRequest(Bank bank, [[maybe_unused]] tlm_command command) const
+{
+    return buffer[bank].byAge.size() >= 2;
+}
+
+const std::vector<unsigned>& SchedulerFrFcfsQoS::getBufferDepth() const
+{
+    return bufferCounter->getBufferDepth();
+}
+
+void SchedulerFrFcfsQoS::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      lastServedThread.has_value(),
+                      lastServedThread.value_or(Thread(0)),
+                      servedInARow,
+                      static_cast<uint64_t>(timeOfBlacklisting.size()));
+
+    for (const auto& [thread, time] : timeOfBlacklisting)
+        Checkpoint::write(stream, thread, time);
+}
+
+void SchedulerFrFcfsQoS::deserialize(std::istream& stream)
+{
+    bool hasLastServedThread = false;
+    auto thread = Thread(0);
+    uint64_t numberOfBlacklistedThreads = 0;
+    Checkpoint::read(stream, hasLastServedThread, thread, servedInARow, numberOfBlacklistedThreads);
+
+    lastServedThread = hasLastServedThread ? std::optional<Thread>(thread) : std::nullopt;
+
+    timeOfBlacklisting.clear();
+    for (uint64_t i = 0; i < numberOfBlacklistedThreads && stream; i++)
+    {
+        sc_time time;
+        Checkpoint::read(stream, thread, time);
+        timeOfBlacklisting[thread] = time;
+    }
+}
+
+} // namespace DRAMSys
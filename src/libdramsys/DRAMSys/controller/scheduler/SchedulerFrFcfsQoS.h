@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SCHEDULERFRFCFSQOS_H
+#define SCHEDULERFRFCFSQOS_H
+
+#include "DRAMSys/common/dramExtensions.h"
+#include "DRAMSys/controller/BankMachine.h"
+#include "DRAMSys/controller/McConfig.h"
+#include "DRAMSys/controller/scheduler/BufferCounterIF.h"
+#include "DRAMSys/controller/scheduler/SchedulerIF.h"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <systemc>
+#include <tlm>
+#include <unordered_map>
+#include <vector>
+
+namespace DRAMSys
+{
+
+// FR-FCFS with quality of service: requests that are older than the maximum request age or that
+// have missed their deadline are served first (earliest deadline, then oldest). Otherwise, the
+// requests of the highest priority class are scheduled, where requests of threads that were
+// blacklisted for being served too many times in a row (BLISS) come last, then row hits, then
+// the oldest request. The requests of each bank are indexed by age, priority, row and deadline.
+class SchedulerFrFcfsQoS final : public SchedulerIF
+{
+public:
+    explicit SchedulerFrFcfsQoS(const McConfig& config, const MemSpec& memSpec);
+    [[nodiscard]] bool hasBufferSpace() const override;
+    void storeRequest(tlm::tlm_generic_payload& payload) override;
+    void removeRequest(tlm::tlm_generic_payload& payload) override;
+    [[nodiscard]] tlm::tlm_generic_payload*
+    getNextRequest(const BankMachine& bankMachine) const override;
+    [[nodiscard]] bool
+    hasFurtherRowHit(Bank bank, Row row, tlm::tlm_command command) const override;
+    [[nodiscard]] bool hasFurtherRequest(Bank bank, tlm::tlm_command command) const override;
+    [[nodiscard]] const std::vector<unsigned>& getBufferDepth() const override;
+
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+
+private:
+    struct Request
+    {
+        tlm::tlm_generic_payload* payload;
+        std::optional<Thread> thread;
+        unsigned int priority;
+        sc_core::sc_time arrival;
+        sc_core::sc_time deadline;
+    };
+
+    // Higher priorities first, then older requests first
+    struct PriorityKey
+    {
+        unsigned int priority;
+        uint64_t sequence;
+
+        bool operator<(const PriorityKey& other) const
+        {
+            return priority != other.priority ? priority > other.priority
+                                              : sequence < other.sequence;
+        }
+    };
+
+    struct BankBuffer
+    {
+        std::map<uint64_t, Request> byAge;
+        std::set<PriorityKey> byPriority;
+        std::map<Row, std::set<PriorityKey>> byRow;
+        std::set<std::pair<sc_core::sc_time, uint64_t>> byDeadline;
+    };
+
+    [[nodiscard]] bool isBlacklisted(const std::optional<Thread>& thread) const;
+    [[nodiscard]] tlm::tlm_generic_payload* selectFrom(const BankBuffer& bankBuffer,
+                                                       const std::set<PriorityKey>& candidates,
+                                                       unsigned int priority,
+                                                       bool skipBlacklisted) const;
+
+    ControllerVector<Bank, BankBuffer> buffer;
+    std::unordered_map<const tlm::tlm_generic_payload*, uint64_t> sequenceOfPayload;
+    uint64_t nextSequence = 0;
+    std::unique_ptr<BufferCounterIF> bufferCounter;
+
+    const sc_core::sc_time maxRequestAge;
+    const unsigned int blacklistingThreshold;
+    const sc_core::sc_time blacklistingInterval;
+
+    // A thread is blacklisted until the end of the current blacklisting interval.
+    std::unordered_map<Thread, sc_core::sc_time> timeOfBlacklisting;
+    std::optional<Thread> lastServedThread;
+    unsigned int servedInARow = 0;
+};
+
+} // namespace DRAMSys
+
+#endif // SCHEDULERFRFCFSQOS_H
@@ -34,6 +34,7 @@
 
 #include "SchedulerGrpFrFcfs.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/controller/scheduler/BufferCounterBankwise.h"
 #include "DRAMSys/controller/scheduler/BufferCounterReadWrite.h"
 #include "DRAMSys/controller/scheduler/BufferCounterShared.h"
@@ -45,8 +46,8 @@ namespace DRAMSys
 
 SchedulerGrpFrFcfs::SchedulerGrpFrFcfs(const McConfig& config, const MemSpec& memSpec)
 {
-    readBuffer = ControllerVector<Bank, std::list<tlm_generic_payload*>>(memSpec.banksPerChannel);
-    writeBuffer = ControllerVector<Bank, std::list<tlm_generic_payload*>>(memSpec.banksPerChannel);
+    readBuffer = ControllerVector<Bank, RequestBuffer>(memSpec.banksPerChannel);
+    writeBuffer = ControllerVector<Bank, RequestBuffer>(memSpec.banksPerChannel);
 
     if (config.schedulerBuffer == Config::SchedulerBufferType::Bankwise)
         bufferCounter = std::make_unique<BufferCounterBankwise>(config.requestBufferSize,
@@ -68,9 +69,9 @@ bool SchedulerGrpFrFcfs::hasBufferSpace() const
 void SchedulerGrpFrFcfs::storeRequest(tlm_generic_payload& payload)
 {
     if (payload.is_read())
-        readBuffer[ControllerExtension::getBank(payload)].push_back(&payload);
+        readBuffer[ControllerExtension::getBank(payload)].push_back(payload);
     else
-        writeBuffer[ControllerExtension::getBank(payload)].push_back(&payload);
+        writeBuffer[ControllerExtension::getBank(payload)].push_back(payload);
     bufferCounter->storeRequest(payload);
 }
 
@@ -81,9 +82,9 @@ void SchedulerGrpFrFcfs::removeRequest(tlm_generic_payload& payload)
     Bank bank = ControllerExtension::getBank(payload);
 
     if (payload.is_read())
-        readBuffer[bank].remove(&payload);
+        readBuffer[bank].remove(payload);
     else
-        writeBuffer[bank].remove(&payload);
+        writeBuffer[bank].remove(payload);
 }
 
 tlm_generic_payload* SchedulerGrpFrFcfs::getNextRequest(const BankMachine& bankMachine) const
@@ -99,12 +100,8 @@ tlm_generic_payload* SchedulerGrpFrFcfs::getNextRequest(const BankMachine& bankM
             if (bankMachine.isActivated())
             {
                 // Search for read row hit
-                Row openRow = bankMachine.getOpenRow();
-                for (auto* it : readBuffer[bank])
-                {
-                    if (ControllerExtension::getRow(*it) == openRow)
-                        return it;
-                }
+                if (auto* rowHit = readBuffer[bank].findRowHit(bankMachine.getOpenRow()))
+                    return rowHit;
             }
             // No read row hit found or bank precharged
             return readBuffer[bank].front();
@@ -114,12 +111,8 @@ tlm_generic_payload* SchedulerGrpFrFcfs::getNextRequest(const BankMachine& bankM
             if (bankMachine.isActivated())
             {
                 // Search for write row hit
-                Row openRow = bankMachine.getOpenRow();
-                for (auto* it : writeBuffer[bank])
-                {
-                    if (ControllerExtension::getRow(*it) == openRow)
-                        return it;
-                }
+                if (auto* rowHit = writeBuffer[bank].findRowHit(bankMachine.getOpenRow()))
+                    return rowHit;
             }
             // No write row hit found or bank precharged
             return writeBuffer[bank].front();
@@ -132,12 +125,8 @@ tlm_generic_payload* SchedulerGrpFrFcfs::getNextRequest(const BankMachine& bankM
         if (bankMachine.isActivated())
         {
             // Search for write row hit
-            Row openRow = bankMachine.getOpenRow();
-            for (auto* it : writeBuffer[bank])
-            {
-                if (ControllerExtension::getRow(*it) == openRow)
-                    return it;
-            }
+            if (auto* rowHit = writeBuffer[bank].findRowHit(bankMachine.getOpenRow()))
+                return rowHit;
         }
         // No write row hit found or bank precharged
         return writeBuffer[bank].front();
@@ -147,12 +136,8 @@ tlm_generic_payload* SchedulerGrpFrFcfs::getNextRequest(const BankMachine& bankM
         if (bankMachine.isActivated())
         {
             // Search for read row hit
-            Row openRow = bankMachine.getOpenRow();
-            for (auto* it : readBuffer[bank])
-            {
-                if (ControllerExtension::getRow(*it) == openRow)
-                    return it;
-            }
+            if (auto* rowHit = readBuffer[bank].findRowHit(bankMachine.getOpenRow()))
+                return rowHit;
         }
         // No read row hit found or bank precharged
         return readBuffer[bank].front();
@@ -163,32 +148,10 @@ tlm_generic_payload* SchedulerGrpFrFcfs::getNextRequest(const BankMachine& bankM
 bool SchedulerGrpFrFcfs::hasFurtherRowHit(Bank bank, Row row, tlm_command command) const
 {
     // TODO: do this based on current RD/WR mode
-    unsigned rowHitCounter = 0;
     if (command == tlm::TLM_READ_COMMAND)
-    {
-        for (auto* it : readBuffer[bank])
-        {
-            if (ControllerExtension::getRow(*it) == row)
-            {
-                rowHitCounter++;
-                if (rowHitCounter == 2)
-                    return true;
-            }
-        }
-        return false;
-    }
+        return readBuffer[bank].hasFurtherRowHit(row);
 
-    for (auto* it : writeBuffer[bank])
-    {
-        if (ControllerExtension::getRow(*it) == row)
-        {
-            rowHitCounter++;
-            if (rowHitCounter == 2)
-                return true;
-        }
-    }
-
-    return false;
+    return writeBuffer[bank].hasFurtherRowHit(row);
 }
 
 bool SchedulerGrpFrFcfs::hasFurtherRequest(Bank bank, tlm_command command) const
@@ -206,4 +169,14 @@ const std::vector<unsigned>& SchedulerGrpFrFcfs::getBufferDepth() const
     return bufferCounter->getBufferDepth();
 }
 
+void SchedulerGrpFrFcfs::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream, lastCommand);
+}
+
+void SchedulerGrpFrFcfs::deserialize(std::istream& stream)
+{
+    Checkpoint::read(stream, lastCommand);
+}
+
 } // namespace DRAMSys
@@ -34,10 +34,14 @@
 
 #include "SchedulerGrpFrFcfsWm.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/controller/scheduler/BufferCounterBankwise.h"
 #include "DRAMSys/controller/scheduler/BufferCounterReadWrite.h"
 #include "DRAMSys/controller/scheduler/BufferCounterShared.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace tlm;
 
 namespace DRAMSys
@@ -45,12 +49,18 @@ namespace DRAMSys
 
 SchedulerGrpFrFcfsWm::SchedulerGrpFrFcfsWm(const McConfig& config, const MemSpec& memSpec) :
     lowWatermark(config.lowWatermark),
-    highWatermark(config.highWatermark)
+    highWatermark(config.highWatermark),
+    adaptiveWatermarks(config.adaptiveWatermarks),
+    writeBufferCapacity(
+        config.schedulerBuffer == Config::SchedulerBufferType::Bankwise
+            ? config.requestBufferSize * memSpec.banksPerChannel
+        : config.schedulerBuffer == Config::SchedulerBufferType::ReadWrite
+            ? config.requestBufferSizeWrite
+            : config.requestBufferSize),
+    tCK(memSpec.tCK)
 {
-    readBuffer =
-        ControllerVector<Bank, std::list<tlm_generic_payload*>>(memSpec.banksPerChannel);
-    writeBuffer =
-        ControllerVector<Bank, std::list<tlm_generic_payload*>>(memSpec.banksPerChannel);
+    readBuffer = ControllerVector<Bank, RequestBuffer>(memSpec.banksPerChannel);
+    writeBuffer = ControllerVector<Bank, RequestBuffer>(memSpec.banksPerChannel);
 
     if (config.schedulerBuffer == Config::SchedulerBufferType::Bankwise)
         bufferCounter = std::make_unique<BufferCounterBankwise>(config.requestBufferSize,
@@ -64,7 +74,8 @@ SchedulerGrpFrFcfsWm::SchedulerGrpFrFcfsWm(const McConfig& config, const MemSpec
     if (lowWatermark == 0 || lowWatermark >= highWatermark)
         SC_REPORT_FATAL("SchedulerGrpFrFcfsWm", "Invalid watermark configuration.");
 
-    SC_REPORT_WARNING("SchedulerGrpFrFcfsWm", "Hazard detection not yet implemented!");
+    SC_REPORT_WARNING("SchedulerGrpFrFcfsWm",
+                      "Hazard detection for partially overlapping requests not yet implemented!");
 }
 
 bool SchedulerGrpFrFcfsWm::hasBufferSpace() const
@@ -75,10 +86,12 @@ bool SchedulerGrpFrFcfsWm::hasBufferSpace() const
 void SchedulerGrpFrFcfsWm::storeRequest(tlm_generic_payload& payload)
 {
     if (payload.is_read())
-        readBuffer[ControllerExtension::getBank(payload)].push_back(&payload);
+        readBuffer[ControllerExtension::getBank(payload)].push_back(payload);
     else
-        writeBuffer[ControllerExtension::getBank(payload)].push_back(&payload);
+        writeBuffer[ControllerExtension::getBank(payload)].push_back(payload);
     bufferCounter->storeRequest(payload);
+
+    writeShare += SMOOTHING_FACTOR * ((payload.is_write() ? 1.0 : 0.0) - writeShare);
     evaluateWriteMode();
 }
 
@@ -88,10 +101,11 @@ void SchedulerGrpFrFcfsWm::removeRequest(tlm_generic_payload& payload)
     Bank bank = ControllerExtension::getBank(payload);
 
     if (payload.is_read())
-        readBuffer[bank].remove(&payload);
+        readBuffer[bank].remove(payload);
     else
-        writeBuffer[bank].remove(&payload);
+        writeBuffer[bank].remove(payload);
 
+    measureTurnaround(payload.is_read());
     evaluateWriteMode();
 }
 
@@ -106,12 +120,8 @@ tlm_generic_payload* SchedulerGrpFrFcfsWm::getNextRequest(const BankMachine& ban
             if (bankMachine.isActivated())
             {
                 // Search for read row hit
-                Row openRow = bankMachine.getOpenRow();
-                for (auto* it : readBuffer[bank])
-                {
-                    if (ControllerExtension::getRow(*it) == openRow)
-                        return it;
-                }
+                if (auto* rowHit = readBuffer[bank].findRowHit(bankMachine.getOpenRow()))
+                    return rowHit;
             }
             // No read row hit found or bank precharged
             return readBuffer[bank].front();
@@ -124,12 +134,8 @@ tlm_generic_payload* SchedulerGrpFrFcfsWm::getNextRequest(const BankMachine& ban
         if (bankMachine.isActivated())
         {
             // Search for write row hit
-            Row openRow = bankMachine.getOpenRow();
-            for (auto* it : writeBuffer[bank])
-            {
-                if (ControllerExtension::getRow(*it) == openRow)
-                    return it;
-            }
+            if (auto* rowHit = writeBuffer[bank].findRowHit(bankMachine.getOpenRow()))
+                return rowHit;
         }
         // No row hit found or bank precharged
         return writeBuffer[bank].front();
@@ -142,32 +148,10 @@ bool SchedulerGrpFrFcfsWm::hasFurtherRowHit(Bank bank,
                                             Row row,
                                             [[maybe_unused]] tlm::tlm_command command) const
 {
-    unsigned rowHitCounter = 0;
     if (!writeMode)
-    {
-        for (const auto* it : readBuffer[bank])
-        {
-            if (ControllerExtension::getRow(*it) == row)
-            {
-                rowHitCounter++;
-                if (rowHitCounter == 2)
-                    return true;
-            }
-        }
-        return false;
-    }
+        return readBuffer[bank].hasFurtherRowHit(row);
 
-    for (auto* it : writeBuffer[bank])
-    {
-        if (ControllerExtension::getRow(*it) == row)
-        {
-            rowHitCounter++;
-            if (rowHitCounter == 2)
-                return true;
-        }
-    }
-
-    return false;
+    return writeBuffer[bank].hasFurtherRowHit(row);
 }
 
 bool SchedulerGrpFrFcfsWm::hasFurtherRequest(Bank bank,
@@ -186,8 +170,35 @@ const std::vector<unsigned>& SchedulerGrpFrFcfsWm::getBufferDepth() const
     return bufferCounter->getBufferDepth();
 }
 
+tlm_generic_payload* SchedulerGrpFrFcfsWm::getForwardingWrite(const tlm_generic_payload& read) const
+{
+    uint64_t readStart = read.get_address();
+    uint64_t readEnd = readStart + read.get_data_length();
+
+    // Only the youngest overlapping write holds the current data.
+    const auto& writes = writeBuffer[ControllerExtension::getBank(read)].getPayloads();
+    for (auto it = writes.rbegin(); it != writes.rend(); it++)
+    {
+        tlm_generic_payload* write = *it;
+        uint64_t writeStart = write->get_address();
+        uint64_t writeEnd = writeStart + write->get_data_length();
+
+        if (writeStart >= readEnd || readStart >= writeEnd)
+            continue;
+
+        bool coversRead = writeStart <= readStart && readEnd <= writeEnd;
+        bool hasByteEnables =
+            write->get_byte_enable_ptr() != nullptr && write->get_byte_enable_length() != 0;
+        return coversRead && !hasByteEnables ? write : nullptr;
+    }
+
+    return nullptr;
+}
+
 void SchedulerGrpFrFcfsWm::evaluateWriteMode()
 {
+    bool previousWriteMode = writeMode;
+
     if (writeMode)
     {
         if (bufferCounter->getNumWriteRequests() <= lowWatermark &&
@@ -200,6 +211,70 @@ void SchedulerGrpFrFcfsWm::evaluateWriteMode()
             bufferCounter->getNumReadRequests() == 0)
             writeMode = true;
     }
+
+    if (writeMode != previousWriteMode)
+        adaptWatermarks();
+}
+
+void SchedulerGrpFrFcfsWm::measureTurnaround(bool isRead)
+{
+    // Only gaps between column commands with pending requests are caused by the bus, other gaps
+    // are idle times.
+    sc_core::sc_time now = sc_core::sc_time_stamp();
+    if (lastCasTime != sc_core::sc_max_time())
+    {
+        double gapCycles = (now - lastCasTime) / tCK;
+
+        if (isRead != lastCasWasRead && otherDirectionPendingAtLastCas)
+        {
+            turnaroundCycles = turnaroundCycles == 0.0
+                                   ? gapCycles
+                                   : turnaroundCycles +
+                                         SMOOTHING_FACTOR * (gapCycles - turnaroundCycles);
+        }
+        else if (isRead == lastCasWasRead && sameDirectionPendingAtLastCas)
+        {
+            casIntervalCycles = casIntervalCycles == 0.0
+                                    ? gapCycles
+                                    : casIntervalCycles +
+                                          SMOOTHING_FACTOR * (gapCycles - casIntervalCycles);
+        }
+    }
+
+    unsigned pendingReads = bufferCounter->getNumReadRequests();
+    unsigned pendingWrites = bufferCounter->getNumWriteRequests();
+
+    lastCasTime = now;
+    lastCasWasRead = isRead;
+    sameDirectionPendingAtLastCas = (isRead ? pendingReads : pendingWrites) != 0;
+    otherDirectionPendingAtLastCas = (isRead ? pendingWrites : pendingReads) != 0;
+}
+
+void SchedulerGrpFrFcfsWm::adaptWatermarks()
+{
+    if (!adaptiveWatermarks || turnaroundCycles == 0.0 || casIntervalCycles == 0.0)
+        return;
+
+    // Number of writes whose data transfer takes as long as one bus turnaround. Write-heavy
+    // traffic needs proportionally longer drains to keep up with the incoming writes.
+    double amortizingDrain = std::ceil(turnaroundCycles / casIntervalCycles);
+    double drain = amortizingDrain / std::max(1.0 - writeShare, MIN_READ_SHARE);
+
+    unsigned maxHighWatermark = std::max(writeBufferCapacity, lowWatermark + 2) - 1;
+    highWatermark = std::clamp(
+        lowWatermark + static_cast<unsigned>(std::ceil(drain)), lowWatermark + 1, maxHighWatermark);
+}
+
+void SchedulerGrpFrFcfsWm::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(
+        stream, writeMode, highWatermark, writeShare, turnaroundCycles, casIntervalCycles);
+}
+
+void SchedulerGrpFrFcfsWm::deserialize(std::istream& stream)
+{
+    Checkpoint::read(
+        stream, writeMode, highWatermark, writeShare, turnaroundCycles, casIntervalCycles);
 }
 
 } // namespace DRAMSys
@@ -38,9 +38,9 @@
 #include "DRAMSys/common/dramExtensions.h"
 #include "DRAMSys/controller/BankMachine.h"
 #include "DRAMSys/controller/scheduler/BufferCounterIF.h"
+#include "DRAMSys/controller/scheduler/RequestBuffer.h"
 #include "DRAMSys/controller/scheduler/SchedulerIF.h"
 
-#include <list>
 #include <memory>
 #include <tlm>
 #include <vector>
@@ -61,16 +61,41 @@ public:
     hasFurtherRowHit(Bank bank, Row row, tlm::tlm_command command) const override;
     [[nodiscard]] bool hasFurtherRequest(Bank bank, tlm::tlm_command command) const override;
     [[nodiscard]] const std::vector<unsigned>& getBufferDepth() const override;
+    [[nodiscard]] tlm::tlm_generic_payload*
+    getForwardingWrite(const tlm::tlm_generic_payload& read) const override;
+
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
 
 private:
     void evaluateWriteMode();
+    void measureTurnaround(bool isRead);
+    void adaptWatermarks();
 
-    ControllerVector<Bank, std::list<tlm::tlm_generic_payload*>> readBuffer;
-    ControllerVector<Bank, std::list<tlm::tlm_generic_payload*>> writeBuffer;
+    ControllerVector<Bank, RequestBuffer> readBuffer;
+    ControllerVector<Bank, RequestBuffer> writeBuffer;
     std::unique_ptr<BufferCounterIF> bufferCounter;
     const unsigned lowWatermark;
-    const unsigned highWatermark;
+    unsigned highWatermark;
     bool writeMode = false;
+
+    // With adaptive watermarks, the high watermark is chosen such that each write drain
+    // amortizes the measured bus turnaround cost, scaled by the share of writes in the traffic.
+    const bool adaptiveWatermarks;
+    const unsigned writeBufferCapacity;
+    const sc_core::sc_time tCK;
+
+    static constexpr double SMOOTHING_FACTOR = 1.0 / 16;
+    static constexpr double MIN_READ_SHARE = 0.1;
+
+    double writeShare = 0.0;
+    double turnaroundCycles = 0.0;
+    double casIntervalCycles = 0.0;
+
+    sc_core::sc_time lastCasTime = sc_core::sc_max_time();
+    bool lastCasWasRead = true;
+    bool sameDirectionPendingAtLastCas = false;
+    bool otherDirectionPendingAtLastCas = false;
 };
 
 } // namespace DRAMSys
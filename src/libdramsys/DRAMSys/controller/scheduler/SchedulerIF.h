@@ -35,6 +35,8 @@
 #ifndef SCHEDULERIF_H
 #define SCHEDULERIF_H
 
+#include "DRAMSys/common/Deserialize.h"
+#include "DRAMSys/common/Serialize.h"
 #include "DRAMSys/common/dramExtensions.h"
 
 #include <tlm>
@@ -45,7 +47,9 @@ namespace DRAMSys
 
 class BankMachine;
 
-class SchedulerIF
+// Checkpoints are only taken while the controller is idle, so the request buffers are empty and
+// only the scheduling state that outlives the requests is part of a checkpoint
+class SchedulerIF : public Serialize, public Deserialize
 {
 protected:
     SchedulerIF(const SchedulerIF&) = default;
@@ -66,6 +70,14 @@ public:
     hasFurtherRowHit(Bank bank, Row row, tlm::tlm_command command) const = 0;
     [[nodiscard]] virtual bool hasFurtherRequest(Bank bank, tlm::tlm_command command) const = 0;
     [[nodiscard]] virtual const std::vector<unsigned>& getBufferDepth() const = 0;
+
+    // Returns a buffered write that holds all data of the given read, so that the read can be
+    // served without accessing the memory. Only schedulers that reorder reads and writes forward.
+    [[nodiscard]] virtual tlm::tlm_generic_payload*
+    getForwardingWrite([[maybe_unused]] const tlm::tlm_generic_payload& read) const
+    {
+        return nullptr;
+    }
 };
 
 } // namespace DRAMSys
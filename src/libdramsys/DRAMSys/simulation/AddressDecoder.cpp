@@ -38,14 +38,67 @@
 
 #include "AddressDecoder.h"
 
+#include <algorithm>
 #include <bitset>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
 
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
 namespace DRAMSys
 {
 
+DecodedAddressExtension::DecodedAddressExtension(uint64_t address,
+                                                 uint64_t mappingId,
+                                                 const DecodedAddress& decodedAddress) :
+    address(address),
+    mappingId(mappingId),
+    decodedAddress(decodedAddress)
+{
+}
+
+void DecodedAddressExtension::setAutoExtension(tlm::tlm_generic_payload& trans,
+                                               uint64_t mappingId,
+                                               const DecodedAddress& decodedAddress)
+{
+    auto* extension = trans.get_extension<DecodedAddressExtension>();
+
+    if (extension != nullptr)
+    {
+        extension->address = trans.get_address();
+        extension->mappingId = mappingId;
+        extension->decodedAddress = decodedAddress;
+    }
+    else
+    {
+        extension = new DecodedAddressExtension(trans.get_address(), mappingId, decodedAddress);
+        trans.set_auto_extension(extension);
+    }
+}
+
+void DecodedAddressExtension::removeAddressOffset(tlm::tlm_generic_payload& trans,
+                                                  uint64_t addressOffset)
+{
+    if (auto* extension = trans.get_extension<DecodedAddressExtension>())
+        extension->address -= addressOffset;
+}
+
+tlm::tlm_extension_base* DecodedAddressExtension::clone() const
+{
+    return new DecodedAddressExtension(address, mappingId, decodedAddress);
+}
+
+void DecodedAddressExtension::copy_from(const tlm::tlm_extension_base& ext)
+{
+    const auto& cpyFrom = dynamic_cast<const DecodedAddressExtension&>(ext);
+    address = cpyFrom.address;
+    mappingId = cpyFrom.mappingId;
+    decodedAddress = cpyFrom.decodedAddress;
+}
+
 static void addMapping(std::vector<Config::AddressMapping::BitEntry> const& mappingVector,
                        std::vector<unsigned>& bitVector,
                        std::vector<std::vector<unsigned>>& xorVector)
@@ -70,6 +123,21 @@ static void addMapping(std::vector<Config::AddressMapping::BitEntry> const& mapp
     }
 }
 
+static inline uint64_t parity(uint64_t value)
+{
+#if defined(__GNUC__)
+    return static_cast<uint64_t>(__builtin_parityll(value));
+#else
+    value ^= value >> 32;
+    value ^= value >> 16;
+    value ^= value >> 8;
+    value ^= value >> 4;
+    value ^= value >> 2;
+    value ^= value >> 1;
+    return value & UINT64_C(1);
+#endif
+}
+
 AddressDecoder::AddressDecoder(const Config::AddressMapping& addressMapping)
 {
     if (const auto& channelBits = addressMapping.CHANNEL_BIT)
@@ -126,6 +194,8 @@ AddressDecoder::AddressDecoder(const Config::AddressMapping& addressMapping)
 
     bankgroupsPerRank = bankGroups;
     banksPerGroup = banks;
+
+    compile();
 }
 
 void AddressDecoder::plausibilityCheck(const MemSpec& memSpec)
@@ -189,61 +259,152 @@ void AddressDecoder::plausibilityCheck(const MemSpec& memSpec)
         SC_REPORT_FATAL("AddressDecoder", "Memspec and address mapping do not match");
 }
 
-DecodedAddress AddressDecoder::decodeAddress(uint64_t encAddr) const
+void AddressDecoder::compile()
 {
-    if (encAddr > maximumAddress)
-        SC_REPORT_WARNING("AddressDecoder",
-                          ("Address " + std::to_string(encAddr) +
-                           " out of range (maximum address is " + std::to_string(maximumAddress) +
-                           ")")
-                              .c_str());
+    for (const auto& gate : vXor)
+    {
+        // A bit that occurs twice in a gate cancels itself out
+        uint64_t mask = 0;
+        for (unsigned bit : gate)
+            mask ^= UINT64_C(1) << bit;
 
-    // Apply XOR
-    // For each used xor:
-    //   Get the first bit and second bit. Apply a bitwise xor operator and save it back to the
-    //   first bit.
-    auto tempAddr = encAddr;
-    for (const auto& it : vXor)
+        xorGates.push_back({gate.at(0), mask});
+    }
+
+    const std::array<const std::vector<unsigned>*, FIELD_COUNT> fieldBits = {
+        &vChannelBits, &vRankBits, &vBankGroupBits, &vBankBits, &vRowBits, &vColumnBits, &vByteBits};
+
+    // FNV-1a hash over all fields and gates
+    auto hash = [this](uint64_t value)
+    {
+        mappingId ^= value;
+        mappingId *= UINT64_C(0x100000001b3);
+    };
+
+    mappingId = UINT64_C(0xcbf29ce484222325);
+    for (const auto* bits : fieldBits)
     {
-        uint64_t xoredBit = std::accumulate(it.cbegin(),
-                                            it.cend(),
-                                            0,
-                                            [tempAddr](uint64_t acc, unsigned xorBit)
-                                            { return acc ^= (tempAddr >> xorBit) & UINT64_C(1); });
-        encAddr &= ~(UINT64_C(1) << it[0]);
-        encAddr |= xoredBit << it[0];
+        for (unsigned bit : *bits)
+            hash(bit);
+        hash(UINT64_MAX);
+    }
+    for (const auto& gate : xorGates)
+    {
+        hash(gate.target);
+        hash(gate.mask);
     }
 
-    DecodedAddress decAddr;
+    unsigned offset = 0;
+    for (unsigned index = 0; index < FIELD_COUNT; index++)
+    {
+        const std::vector<unsigned>& bits = *fieldBits[index];
+        Field& field = fields[index];
+        field.offset = offset;
+        field.width = static_cast<unsigned>(bits.size());
+        offset += field.width;
 
-    for (unsigned it = 0; it < vChannelBits.size(); it++)
-        decAddr.channel |= ((encAddr >> vChannelBits[it]) & UINT64_C(1)) << it;
+        if (offset > 64)
+            SC_REPORT_FATAL("AddressDecoder", "Address mapping has more than 64 bits");
 
-    for (unsigned it = 0; it < vRankBits.size(); it++)
-        decAddr.rank |= ((encAddr >> vRankBits[it]) & UINT64_C(1)) << it;
+        for (unsigned position = 0; position < bits.size(); position++)
+        {
+            unsigned addressBit = bits[position];
+            unsigned packedBit = field.offset + position;
 
-    for (unsigned it = 0; it < vBankGroupBits.size(); it++)
-        decAddr.bankgroup |= ((encAddr >> vBankGroupBits[it]) & UINT64_C(1)) << it;
+            if (addressBit >= 64)
+                SC_REPORT_FATAL("AddressDecoder", "Address bit out of range");
 
-    for (unsigned it = 0; it < vBankBits.size(); it++)
-        decAddr.bank |= ((encAddr >> vBankBits[it]) & UINT64_C(1)) << it;
+            // PEXT and PDEP keep the order of the bits in the mask
+            if (position > 0 && addressBit <= bits[position - 1])
+                orderedFields = false;
 
-    for (unsigned it = 0; it < vRowBits.size(); it++)
-        decAddr.row |= ((encAddr >> vRowBits[it]) & UINT64_C(1)) << it;
+            field.mask |= UINT64_C(1) << addressBit;
+            addressBytes = std::max(addressBytes, addressBit / 8 + 1);
+            packedBytes = std::max(packedBytes, packedBit / 8 + 1);
 
-    for (unsigned it = 0; it < vColumnBits.size(); it++)
-        decAddr.column |= ((encAddr >> vColumnBits[it]) & UINT64_C(1)) << it;
+            for (unsigned value = 0; value < 256; value++)
+            {
+                if (((value >> (addressBit % 8)) & 1U) != 0)
+                    gatherTable[addressBit / 8][value] |= UINT64_C(1) << packedBit;
 
-    for (unsigned it = 0; it < vByteBits.size(); it++)
-        decAddr.byte |= ((encAddr >> vByteBits[it]) & UINT64_C(1)) << it;
+                if (((value >> (packedBit % 8)) & 1U) != 0)
+                    scatterTable[packedBit / 8][value] |= UINT64_C(1) << addressBit;
+            }
+        }
+    }
+}
 
-    decAddr.bankgroup = decAddr.bankgroup + decAddr.rank * bankgroupsPerRank;
-    decAddr.bank = decAddr.bank + decAddr.bankgroup * banksPerGroup;
+uint64_t AddressDecoder::applyXor(uint64_t address) const
+{
+    // The target bit of each gate is replaced by the parity of all bits of the gate in the
+    // original address
+    uint64_t result = address;
+    for (const auto& gate : xorGates)
+    {
+        result &= ~(UINT64_C(1) << gate.target);
+        result |= parity(address & gate.mask) << gate.target;
+    }
+    return result;
+}
 
-    return decAddr;
+uint64_t AddressDecoder::gather(uint64_t address) const
+{
+    uint64_t packed = 0;
+
+#ifdef __BMI2__
+    if (orderedFields)
+    {
+        for (const auto& field : fields)
+        {
+            if (field.width != 0)
+                packed |= _pext_u64(address, field.mask) << field.offset;
+        }
+        return packed;
+    }
+#endif
+
+    for (unsigned byte = 0; byte < addressBytes; byte++)
+        packed |= gatherTable[byte][(address >> (8 * byte)) & 0xFF];
+
+    return packed;
 }
 
-unsigned AddressDecoder::decodeChannel(uint64_t encAddr) const
+uint64_t AddressDecoder::scatter(uint64_t packed) const
+{
+    uint64_t address = 0;
+
+#ifdef __BMI2__
+    if (orderedFields)
+    {
+        for (const auto& field : fields)
+        {
+            if (field.width != 0)
+                address |= _pdep_u64(packed >> field.offset, field.mask);
+        }
+        return address;
+    }
+#endif
+
+    for (unsigned byte = 0; byte < packedBytes; byte++)
+        address |= scatterTable[byte][(packed >> (8 * byte)) & 0xFF];
+
+    return address;
+}
+
+unsigned AddressDecoder::extract(uint64_t packed, FieldIndex field) const
+{
+    const Field& layout = fields[field];
+    if (layout.width == 0)
+        return 0;
+
+    uint64_t value = packed >> layout.offset;
+    if (layout.width < 64)
+        value &= (UINT64_C(1) << layout.width) - 1;
+
+    return static_cast<unsigned>(value);
+}
+
+void AddressDecoder::checkRange(uint64_t encAddr) const
 {
     if (encAddr > maximumAddress)
         SC_REPORT_WARNING("AddressDecoder",
@@ -251,63 +412,151 @@ unsigned AddressDecoder::decodeChannel(uint64_t encAddr) const
                            " out of range (maximum address is " + std::to_string(maximumAddress) +
                            ")")
                               .c_str());
+}
 
-    // Apply XOR
-    // For each used xor:
-    //   Get the first bit and second bit. Apply a bitwise xor operator and save it back to the
-    //   first bit.
-    auto tempAddr = encAddr;
-    for (const auto& it : vXor)
+DecodedAddress AddressDecoder::unpack(uint64_t packed) const
+{
+    DecodedAddress decAddr;
+    decAddr.channel = extract(packed, CHANNEL);
+    decAddr.rank = extract(packed, RANK);
+    decAddr.bankgroup = extract(packed, BANKGROUP);
+    decAddr.bank = extract(packed, BANK);
+    decAddr.row = extract(packed, ROW);
+    decAddr.column = extract(packed, COLUMN);
+    decAddr.byte = extract(packed, BYTE);
+
+    decAddr.bankgroup = decAddr.bankgroup + decAddr.rank * bankgroupsPerRank;
+    decAddr.bank = decAddr.bank + decAddr.bankgroup * banksPerGroup;
+
+    return decAddr;
+}
+
+DecodedAddress AddressDecoder::decodeAddress(uint64_t encAddr) const
+{
+    checkRange(encAddr);
+    return unpack(gather(applyXor(encAddr)));
+}
+
+void AddressDecoder::decodeAddresses(const uint64_t* encAddrs,
+                                     DecodedAddress* decAddrs,
+                                     std::size_t count) const
+{
+    static constexpr std::size_t CHUNK_SIZE = 64;
+    std::array<uint64_t, CHUNK_SIZE> xored{};
+    std::array<uint64_t, CHUNK_SIZE> packed{};
+
+    for (std::size_t first = 0; first < count; first += CHUNK_SIZE)
     {
-        uint64_t xoredBit = std::accumulate(it.cbegin(),
-                                            it.cend(),
-                                            0,
-                                            [tempAddr](uint64_t acc, unsigned xorBit)
-                                            { return acc ^= (tempAddr >> xorBit) & UINT64_C(1); });
-        encAddr &= ~(UINT64_C(1) << it[0]);
-        encAddr |= xoredBit << it[0];
+        std::size_t size = std::min(CHUNK_SIZE, count - first);
+        const uint64_t* chunk = encAddrs + first;
+
+        for (std::size_t index = 0; index < size; index++)
+            checkRange(chunk[index]);
+
+        std::copy(chunk, chunk + size, xored.begin());
+        for (const auto& gate : xorGates)
+        {
+            uint64_t targetMask = ~(UINT64_C(1) << gate.target);
+            for (std::size_t index = 0; index < size; index++)
+                xored[index] = (xored[index] & targetMask) |
+                               (parity(chunk[index] & gate.mask) << gate.target);
+        }
+
+#ifdef __BMI2__
+        if (orderedFields)
+        {
+            for (std::size_t index = 0; index < size; index++)
+                packed[index] = gather(xored[index]);
+        }
+        else
+#endif
+        {
+            std::fill(packed.begin(), packed.end(), 0);
+            for (unsigned byte = 0; byte < addressBytes; byte++)
+            {
+                const auto& table = gatherTable[byte];
+                for (std::size_t index = 0; index < size; index++)
+                    packed[index] |= table[(xored[index] >> (8 * byte)) & 0xFF];
+            }
+        }
+
+        for (std::size_t index = 0; index < size; index++)
+            decAddrs[first + index] = unpack(packed[index]);
     }
+}
+
+const DecodedAddress* AddressDecoder::predecoded(const tlm::tlm_generic_payload& trans) const
+{
+    const auto* extension = trans.get_extension<DecodedAddressExtension>();
+    if (extension != nullptr && extension->mappingId == mappingId &&
+        extension->address == trans.get_address())
+        return &extension->decodedAddress;
 
-    unsigned channel = 0;
+    return nullptr;
+}
 
-    for (unsigned it = 0; it < vChannelBits.size(); it++)
-        channel |= ((encAddr >> vChannelBits[it]) & UINT64_C(1)) << it;
+DecodedAddress AddressDecoder::decodeAddress(const tlm::tlm_generic_payload& trans) const
+{
+    if (const DecodedAddress* decodedAddress = predecoded(trans))
+        return *decodedAddress;
 
-    return channel;
+    return decodeAddress(trans.get_address());
 }
 
-uint64_t AddressDecoder::encodeAddress(DecodedAddress decodedAddress) const
+unsigned AddressDecoder::decodeChannel(const tlm::tlm_generic_payload& trans) const
 {
-    // Convert absoulte addressing for bank, bankgroup to relative
-    decodedAddress.bankgroup = decodedAddress.bankgroup % bankgroupsPerRank;
-    decodedAddress.bank = decodedAddress.bank % banksPerGroup;
+    if (const DecodedAddress* decodedAddress = predecoded(trans))
+        return decodedAddress->channel;
 
-    uint64_t address = 0;
+    return decodeChannel(trans.get_address());
+}
 
-    for (unsigned i = 0; i < vChannelBits.size(); i++)
-        address |= ((decodedAddress.channel >> i) & 0x1) << vChannelBits[i];
+unsigned AddressDecoder::decodeChannel(uint64_t encAddr) const
+{
+    checkRange(encAddr);
 
-    for (unsigned i = 0; i < vRankBits.size(); i++)
-        address |= ((decodedAddress.rank >> i) & 0x1) << vRankBits[i];
+    uint64_t address = applyXor(encAddr);
 
-    for (unsigned i = 0; i < vBankGroupBits.size(); i++)
-        address |= ((decodedAddress.bankgroup >> i) & 0x1) << vBankGroupBits[i];
+#ifdef __BMI2__
+    if (orderedFields)
+        return static_cast<unsigned>(_pext_u64(address, fields[CHANNEL].mask));
+#endif
 
-    for (unsigned i = 0; i < vBankBits.size(); i++)
-        address |= ((decodedAddress.bank >> i) & 0x1) << vBankBits[i];
+    return extract(gather(address), CHANNEL);
+}
 
-    for (unsigned i = 0; i < vRowBits.size(); i++)
-        address |= ((decodedAddress.row >> i) & 0x1) << vRowBits[i];
+uint64_t AddressDecoder::encodeAddress(DecodedAddress decodedAddress) const
+{
+    // Convert absoulte addressing for bank, bankgroup to relative
+    decodedAddress.bankgroup = decodedAddress.bankgroup % bankgroupsPerRank;
+    decodedAddress.bank = decodedAddress.bank % banksPerGroup;
 
-    for (unsigned i = 0; i < vColumnBits.size(); i++)
-        address |= ((decodedAddress.column >> i) & 0x1) << vColumnBits[i];
+    const std::array<unsigned, FIELD_COUNT> values = {decodedAddress.channel,
+                                                      decodedAddress.rank,
+                                                      decodedAddress.bankgroup,
+                                                      decodedAddress.bank,
+                                                      decodedAddress.row,
+                                                      decodedAddress.column,
+                                                      decodedAddress.byte};
+
+    // Only the lower bits of each value that fit into its field are used
+    uint64_t packed = 0;
+    for (unsigned index = 0; index < FIELD_COUNT; index++)
+    {
+        const Field& field = fields[index];
+        if (field.width == 0)
+            continue;
 
-    for (unsigned i = 0; i < vByteBits.size(); i++)
-        address |= ((decodedAddress.byte >> i) & 0x1) << vByteBits[i];
+        uint64_t value = values[index];
+        if (field.width < 64)
+            value &= (UINT64_C(1) << field.width) - 1;
 
-    // TODO: XOR encoding
+        packed |= value << field.offset;
+    }
 
-    return address;
+    // Applying the gates again in decodeAddress restores the original value of the target bits,
+    // as long as the other bits of a gate are not targets themselves
+    return applyXor(scatter(packed));
 }
 
 void AddressDecoder::print() const
@@ -42,6 +42,8 @@
 #include "DRAMSys/config/DRAMSysConfiguration.h"
 #include "DRAMSys/configuration/memspec/MemSpec.h"
 
+#include <array>
+#include <tlm>
 #include <utility>
 #include <vector>
 
@@ -78,6 +80,34 @@ struct DecodedAddress
     unsigned byte = 0;
 };
 
+// Coordinates that an initiator decoded in advance, e.g. once for a trace that is replayed several
+// times. They are only used if they were decoded for the current address of the payload with the
+// active address mapping.
+class DecodedAddressExtension : public tlm::tlm_extension<DecodedAddressExtension>
+{
+public:
+    static void setAutoExtension(tlm::tlm_generic_payload& trans,
+                                 uint64_t mappingId,
+                                 const DecodedAddress& decodedAddress);
+
+    // Keeps the extension valid when the address offset of DRAMSys is removed from the payload
+    static void removeAddressOffset(tlm::tlm_generic_payload& trans, uint64_t addressOffset);
+
+    [[nodiscard]] tlm::tlm_extension_base* clone() const override;
+    void copy_from(const tlm::tlm_extension_base& ext) override;
+
+private:
+    DecodedAddressExtension(uint64_t address,
+                            uint64_t mappingId,
+                            const DecodedAddress& decodedAddress);
+
+    uint64_t address;
+    uint64_t mappingId;
+    DecodedAddress decodedAddress;
+
+    friend class AddressDecoder;
+};
+
 class AddressDecoder
 {
 public:
@@ -86,12 +116,71 @@ public:
     [[nodiscard]] DecodedAddress decodeAddress(uint64_t encAddr) const;
     [[nodiscard]] unsigned decodeChannel(uint64_t encAddr) const;
     [[nodiscard]] uint64_t encodeAddress(DecodedAddress decodedAddress) const;
+
+    // Decodes count addresses at once. The addresses are processed in chunks with one loop per
+    // step, which keeps the loops free of dependencies so that the compiler can vectorize them.
+    void decodeAddresses(const uint64_t* encAddrs, DecodedAddress* decAddrs, std::size_t count) const;
+
+    // Use the coordinates of a valid DecodedAddressExtension instead of decoding the address
+    [[nodiscard]] DecodedAddress decodeAddress(const tlm::tlm_generic_payload& trans) const;
+    [[nodiscard]] unsigned decodeChannel(const tlm::tlm_generic_payload& trans) const;
+
+    // Identifies the address mapping, decoded coordinates are only valid for the same mapping
+    [[nodiscard]] uint64_t getMappingId() const { return mappingId; }
     [[nodiscard]] uint64_t maxAddress() const { return maximumAddress; }
+    [[nodiscard]] unsigned rowsPerBank() const { return 1U << vRowBits.size(); }
 
     void print() const;
     void plausibilityCheck(const MemSpec &memSpec);
 
 private:
+    // The mapping is compiled once into XOR parity masks and a packed representation in which
+    // every field occupies consecutive bits. Addresses are gathered into the packed form with
+    // PEXT if BMI2 is available and the bits of every field ascend, otherwise with lookup tables
+    // that map each address byte to its packed bits.
+    struct XorGate
+    {
+        unsigned target;
+        uint64_t mask;
+    };
+
+    struct Field
+    {
+        uint64_t mask = 0;
+        unsigned offset = 0;
+        unsigned width = 0;
+    };
+
+    enum FieldIndex
+    {
+        CHANNEL,
+        RANK,
+        BANKGROUP,
+        BANK,
+        ROW,
+        COLUMN,
+        BYTE,
+        FIELD_COUNT
+    };
+
+    void compile();
+    [[nodiscard]] uint64_t applyXor(uint64_t address) const;
+    [[nodiscard]] uint64_t gather(uint64_t address) const;
+    [[nodiscard]] uint64_t scatter(uint64_t packed) const;
+    [[nodiscard]] unsigned extract(uint64_t packed, FieldIndex field) const;
+    [[nodiscard]] DecodedAddress unpack(uint64_t packed) const;
+    [[nodiscard]] const DecodedAddress* predecoded(const tlm::tlm_generic_payload& trans) const;
+    void checkRange(uint64_t encAddr) const;
+
+    std::vector<XorGate> xorGates;
+    std::array<Field, FIELD_COUNT> fields;
+    bool orderedFields = true;
+    uint64_t mappingId = 0;
+    unsigned addressBytes = 0;
+    unsigned packedBytes = 0;
+    std::array<std::array<uint64_t, 256>, 8> gatherTable{};
+    std::array<std::array<uint64_t, 256>, 8> scatterTable{};
+
     unsigned banksPerGroup;
     unsigned bankgroupsPerRank;
 
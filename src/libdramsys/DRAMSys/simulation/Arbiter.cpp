@@ -43,6 +43,9 @@
 #include "DRAMSys/config/DRAMSysConfiguration.h"
 #include "DRAMSys/simulation/AddressDecoder.h"
 
+#include <algorithm>
+#include <optional>
+
 using namespace sc_core;
 using namespace tlm;
 
@@ -53,10 +56,12 @@ Arbiter::Arbiter(const sc_module_name& name,
                  const SimConfig& simConfig,
                  const McConfig& mcConfig,
                  const MemSpec& memSpec,
-                 const AddressDecoder& addressDecoder) :
+                 const AddressDecoder& addressDecoder,
+                 std::vector<ThreadQoS> threadQoS) :
     sc_module(name),
     addressDecoder(addressDecoder),
-    payloadEventQueue(this, &Arbiter::peqCallback),
+    payloadEventQueue(this, &Arbiter::peqCallback, memSpec.tCK),
+    threadQoS(std::move(threadQoS)),
     tCK(memSpec.tCK),
     arbitrationDelayFw(mcConfig.arbitrationDelayFw),
     arbitrationDelayBw(mcConfig.arbitrationDelayBw),
@@ -73,8 +78,9 @@ ArbiterSimple::ArbiterSimple(const sc_module_name& name,
                              const SimConfig& simConfig,
                              const McConfig& mcConfig,
                              const MemSpec& memSpec,
-                             const AddressDecoder& addressDecoder) :
-    Arbiter(name, simConfig, mcConfig, memSpec, addressDecoder)
+                             const AddressDecoder& addressDecoder,
+                             std::vector<ThreadQoS> threadQoS) :
+    Arbiter(name, simConfig, mcConfig, memSpec, addressDecoder, std::move(threadQoS))
 {
 }
 
@@ -82,8 +88,9 @@ ArbiterFifo::ArbiterFifo(const sc_module_name& name,
                          const SimConfig& simConfig,
                          const McConfig& mcConfig,
                          const MemSpec& memSpec,
-                         const AddressDecoder& addressDecoder) :
-    Arbiter(name, simConfig, mcConfig, memSpec, addressDecoder),
+                         const AddressDecoder& addressDecoder,
+                         std::vector<ThreadQoS> threadQoS) :
+    Arbiter(name, simConfig, mcConfig, memSpec, addressDecoder, std::move(threadQoS)),
     maxActiveTransactionsPerThread(mcConfig.maxActiveTransactions)
 {
 }
@@ -92,15 +99,33 @@ ArbiterReorder::ArbiterReorder(const sc_module_name& name,
                                const SimConfig& simConfig,
                                const McConfig& mcConfig,
                                const MemSpec& memSpec,
-                               const AddressDecoder& addressDecoder) :
-    Arbiter(name, simConfig, mcConfig, memSpec, addressDecoder),
+                               const AddressDecoder& addressDecoder,
+                               std::vector<ThreadQoS> threadQoS) :
+    Arbiter(name, simConfig, mcConfig, memSpec, addressDecoder, std::move(threadQoS)),
     maxActiveTransactions(mcConfig.maxActiveTransactions)
 {
 }
 
+ArbiterQoS::ArbiterQoS(const sc_module_name& name,
+                       const SimConfig& simConfig,
+                       const McConfig& mcConfig,
+                       const MemSpec& memSpec,
+                       const AddressDecoder& addressDecoder,
+                       std::vector<ThreadQoS> threadQoS) :
+    Arbiter(name, simConfig, mcConfig, memSpec, addressDecoder, std::move(threadQoS)),
+    maxActiveTransactionsPerThread(mcConfig.maxActiveTransactions),
+    quantum(memSpec.defaultBytesPerBurst)
+{
+}
+
 void Arbiter::end_of_elaboration()
 {
     // initiator side
+    qosOnThread = ControllerVector<Thread, ThreadQoS>(tSocket.size(), ThreadQoS());
+    std::size_t configuredThreads = std::min<std::size_t>(threadQoS.size(), tSocket.size());
+    for (std::size_t thread = 0; thread < configuredThreads; thread++)
+        qosOnThread[Thread(thread)] = threadQoS[thread];
+
     threadIsBusy = ControllerVector<Thread, bool>(tSocket.size(), false);
     nextThreadPayloadIDToAppend = ControllerVector<Thread, std::uint64_t>(tSocket.size(), 1);
 
@@ -143,15 +168,53 @@ void ArbiterReorder::end_of_elaboration()
     activeTransactionsOnThread = ControllerVector<Thread, unsigned int>(tSocket.size(), 0);
     outstandingEndReqOnThread =
         ControllerVector<Thread, tlm_generic_payload*>(tSocket.size(), nullptr);
-    pendingResponsesOnThread =
-        ControllerVector<Thread, std::set<tlm_generic_payload*, ThreadPayloadIDCompare>>(
-            tSocket.size(), std::set<tlm_generic_payload*, ThreadPayloadIDCompare>());
-    nextThreadPayloadIDToReturn = ControllerVector<Thread, std::uint64_t>(tSocket.size(), 1);
+    pendingResponsesOnThread = ControllerVector<Thread, ReorderWindow>(
+        tSocket.size(), ReorderWindow(maxActiveTransactions));
 
     lastEndReqOnChannel = ControllerVector<Channel, sc_time>(iSocket.size(), sc_max_time());
     lastEndRespOnThread = ControllerVector<Thread, sc_time>(tSocket.size(), sc_max_time());
 }
 
+void ArbiterQoS::end_of_elaboration()
+{
+    Arbiter::end_of_elaboration();
+
+    // initiator side
+    activeTransactionsOnThread = ControllerVector<Thread, unsigned int>(tSocket.size(), 0);
+    outstandingEndReqOnThread =
+        ControllerVector<Thread, tlm_generic_payload*>(tSocket.size(), nullptr);
+    pendingResponsesOnThread = ControllerVector<Thread, std::queue<tlm_generic_payload*>>(
+        tSocket.size(), std::queue<tlm_generic_payload*>());
+    responsesOnThread = ControllerVector<Thread, std::uint64_t>(tSocket.size(), 0);
+    deadlineMissesOnThread = ControllerVector<Thread, std::uint64_t>(tSocket.size(), 0);
+
+    // channel side
+    pendingRequestsOfThreadOnChannel =
+        ControllerVector<Channel, ControllerVector<Thread, std::queue<tlm_generic_payload*>>>(
+            iSocket.size(),
+            ControllerVector<Thread, std::queue<tlm_generic_payload*>>(
+                tSocket.size(), std::queue<tlm_generic_payload*>()));
+    deficitOfThreadOnChannel = ControllerVector<Channel, ControllerVector<Thread, std::uint64_t>>(
+        iSocket.size(), ControllerVector<Thread, std::uint64_t>(tSocket.size(), 0));
+    roundRobinThreadOnChannel = ControllerVector<Channel, unsigned int>(iSocket.size(), 0);
+
+    lastEndReqOnChannel = ControllerVector<Channel, sc_time>(iSocket.size(), sc_max_time());
+    lastEndRespOnThread = ControllerVector<Thread, sc_time>(tSocket.size(), sc_max_time());
+}
+
+void ArbiterQoS::end_of_simulation()
+{
+    for (std::size_t thread = 0; thread < tSocket.size(); thread++)
+    {
+        if (qosOnThread[Thread(thread)].deadline == SC_ZERO_TIME)
+            continue;
+
+        std::cout << name() << std::string("  Thread ") << thread
+                  << std::string(" deadline misses: ") << deadlineMissesOnThread[Thread(thread)]
+                  << " of " << responsesOnThread[Thread(thread)] << std::endl;
+    }
+}
+
 tlm_sync_enum
 Arbiter::nb_transport_fw(int id, tlm_generic_payload& trans, tlm_phase& phase, sc_time& fwDelay)
 {
@@ -164,11 +227,18 @@ Arbiter::nb_transport_fw(int id, tlm_generic_payload& trans, tlm_phase& phase, s
         // adjust address offset:
         uint64_t adjustedAddress = trans.get_address() - addressOffset;
         trans.set_address(adjustedAddress);
+        DecodedAddressExtension::removeAddressOffset(trans, addressOffset);
 
-        unsigned channel = addressDecoder.decodeChannel(adjustedAddress);
+        unsigned channel = addressDecoder.decodeChannel(trans);
         assert(addressDecoder.decodeChannel(adjustedAddress + trans.get_data_length() - 1) ==
                channel);
         ArbiterExtension::setAutoExtension(trans, Thread(id), Channel(channel));
+
+        const ThreadQoS& qos = qosOnThread[Thread(id)];
+        sc_time deadline = qos.deadline == SC_ZERO_TIME
+                               ? sc_max_time()
+                               : sc_time_stamp() + notDelay + qos.deadline;
+        ArbiterExtension::setQoS(trans, qos.priority, deadline);
         trans.acquire();
     }
 
@@ -194,23 +264,26 @@ void Arbiter::b_transport([[maybe_unused]] int id,
                           sc_core::sc_time& delay)
 {
     trans.set_address(trans.get_address() - addressOffset);
+    DecodedAddressExtension::removeAddressOffset(trans, addressOffset);
 
-    DecodedAddress decodedAddress = addressDecoder.decodeAddress(trans.get_address());
+    DecodedAddress decodedAddress = addressDecoder.decodeAddress(trans);
     iSocket[static_cast<int>(decodedAddress.channel)]->b_transport(trans, delay);
 }
 
 unsigned int Arbiter::transport_dbg([[maybe_unused]] int id, tlm::tlm_generic_payload& trans)
 {
     trans.set_address(trans.get_address() - addressOffset);
+    DecodedAddressExtension::removeAddressOffset(trans, addressOffset);
 
-    DecodedAddress decodedAddress = addressDecoder.decodeAddress(trans.get_address());
+    DecodedAddress decodedAddress = addressDecoder.decodeAddress(trans);
     return iSocket[static_cast<int>(decodedAddress.channel)]->transport_dbg(trans);
 }
 
 void ArbiterSimple::peqCallback(tlm_generic_payload& cbTrans, const tlm_phase& cbPhase)
 {
-    Thread thread = ArbiterExtension::getThread(cbTrans);
-    Channel channel = ArbiterExtension::getChannel(cbTrans);
+    const ArbiterExtension& extension = ArbiterExtension::getExtension(cbTrans);
+    Thread thread = extension.getThread();
+    Channel channel = extension.getChannel();
 
     if (cbPhase == BEGIN_REQ) // from initiator
     {
@@ -301,8 +374,9 @@ void ArbiterSimple::peqCallback(tlm_generic_payload& cbTrans, const tlm_phase& c
 
 void ArbiterFifo::peqCallback(tlm_generic_payload& cbTrans, const tlm_phase& cbPhase)
 {
-    Thread thread = ArbiterExtension::getThread(cbTrans);
-    Channel channel = ArbiterExtension::getChannel(cbTrans);
+    const ArbiterExtension& extension = ArbiterExtension::getExtension(cbTrans);
+    Thread thread = extension.getThread();
+    Channel channel = extension.getChannel();
 
     if (cbPhase == BEGIN_REQ) // from initiator
     {
@@ -431,8 +505,9 @@ void ArbiterFifo::peqCallback(tlm_generic_payload& cbTrans, const tlm_phase& cbP
 
 void ArbiterReorder::peqCallback(tlm_generic_payload& cbTrans, const tlm_phase& cbPhase)
 {
-    Thread thread = ArbiterExtension::getThread(cbTrans);
-    Channel channel = ArbiterExtension::getChannel(cbTrans);
+    const ArbiterExtension& extension = ArbiterExtension::getExtension(cbTrans);
+    Thread thread = extension.getThread();
+    Channel channel = extension.getChannel();
 
     if (cbPhase == BEGIN_REQ) // from initiator
     {
@@ -502,13 +577,10 @@ void ArbiterReorder::peqCallback(tlm_generic_payload& cbTrans, const tlm_phase&
         else
             activeTransactionsOnThread[thread]--;
 
-        tlm_generic_payload& tPayload = **pendingResponsesOnThread[thread].begin();
-
-        if (!pendingResponsesOnThread[thread].empty() &&
-            ArbiterExtension::getThreadPayloadID(tPayload) == nextThreadPayloadIDToReturn[thread])
+        if (tlm_generic_payload* nextPayload = pendingResponsesOnThread[thread].next())
         {
-            nextThreadPayloadIDToReturn[thread]++;
-            pendingResponsesOnThread[thread].erase(pendingResponsesOnThread[thread].begin());
+            tlm_generic_payload& tPayload = *nextPayload;
+            pendingResponsesOnThread[thread].pop();
 
             tlm_phase tPhase = BEGIN_RESP;
             sc_time tDelay = tCK;
@@ -540,19 +612,16 @@ void ArbiterReorder::peqCallback(tlm_generic_payload& cbTrans, const tlm_phase&
     }
     else if (cbPhase == RESP_ARBITRATION)
     {
-        pendingResponsesOnThread[thread].insert(&cbTrans);
+        pendingResponsesOnThread[thread].insert(cbTrans);
 
         if (!threadIsBusy[thread])
         {
-            tlm_generic_payload& tPayload = **pendingResponsesOnThread[thread].begin();
-
-            if (ArbiterExtension::getThreadPayloadID(tPayload) ==
-                nextThreadPayloadIDToReturn[thread])
+            if (tlm_generic_payload* nextPayload = pendingResponsesOnThread[thread].next())
             {
+                tlm_generic_payload& tPayload = *nextPayload;
                 threadIsBusy[thread] = true;
 
-                nextThreadPayloadIDToReturn[thread]++;
-                pendingResponsesOnThread[thread].erase(pendingResponsesOnThread[thread].begin());
+                pendingResponsesOnThread[thread].pop();
                 tlm_phase tPhase = BEGIN_RESP;
                 sc_time tDelay =
                     lastEndRespOnThread[thread] == sc_time_stamp() ? tCK : SC_ZERO_TIME;
@@ -569,4 +638,254 @@ void ArbiterReorder::peqCallback(tlm_generic_payload& cbTrans, const tlm_phase&
         SC_REPORT_FATAL(0, "Payload event queue in arbiter was triggered with unknown phase");
 }
 
+void ArbiterQoS::peqCallback(tlm_generic_payload& cbTrans, const tlm_phase& cbPhase)
+{
+    const ArbiterExtension& extension = ArbiterExtension::getExtension(cbTrans);
+    Thread thread = extension.getThread();
+    Channel channel = extension.getChannel();
+
+    if (cbPhase == BEGIN_REQ) // from initiator
+    {
+        if (activeTransactionsOnThread[thread] < maxActiveTransactionsPerThread)
+        {
+            activeTransactionsOnThread[thread]++;
+
+            ArbiterExtension::setIDAndTimeOfGeneration(
+                cbTrans, nextThreadPayloadIDToAppend[thread]++, sc_time_stamp());
+
+            tlm_phase tPhase = END_REQ;
+            sc_time tDelay = SC_ZERO_TIME;
+
+            tSocket[static_cast<int>(thread)]->nb_transport_bw(cbTrans, tPhase, tDelay);
+
+            payloadEventQueue.notify(cbTrans, REQ_ARBITRATION, arbitrationDelayFw);
+        }
+        else
+            outstandingEndReqOnThread[thread] = &cbTrans;
+    }
+    else if (cbPhase == END_REQ) // from memory controller
+    {
+        lastEndReqOnChannel[channel] = sc_time_stamp();
+
+        if (tlm_generic_payload* nextPayload = selectRequest(channel))
+        {
+            tlm_phase tPhase = BEGIN_REQ;
+            sc_time tDelay = tCK;
+
+            iSocket[static_cast<int>(channel)]->nb_transport_fw(*nextPayload, tPhase, tDelay);
+        }
+        else
+            channelIsBusy[channel] = false;
+    }
+    else if (cbPhase == BEGIN_RESP) // from memory controller
+    {
+        // TODO: use early completion
+        {
+            tlm_phase tPhase = END_RESP;
+            sc_time tDelay = SC_ZERO_TIME;
+
+            iSocket[static_cast<int>(channel)]->nb_transport_fw(cbTrans, tPhase, tDelay);
+        }
+
+        payloadEventQueue.notify(cbTrans, RESP_ARBITRATION, arbitrationDelayBw);
+    }
+    else if (cbPhase == END_RESP) // from initiator
+    {
+        lastEndRespOnThread[thread] = sc_time_stamp();
+        cbTrans.release();
+
+        if (outstandingEndReqOnThread[thread] != nullptr)
+        {
+            tlm_generic_payload& tPayload = *outstandingEndReqOnThread[thread];
+            outstandingEndReqOnThread[thread] = nullptr;
+            tlm_phase tPhase = END_REQ;
+            sc_time tDelay = SC_ZERO_TIME;
+
+            ArbiterExtension::setIDAndTimeOfGeneration(
+                tPayload, nextThreadPayloadIDToAppend[thread]++, sc_time_stamp());
+
+            tSocket[static_cast<int>(thread)]->nb_transport_bw(tPayload, tPhase, tDelay);
+
+            payloadEventQueue.notify(tPayload, REQ_ARBITRATION, arbitrationDelayFw);
+        }
+        else
+            activeTransactionsOnThread[thread]--;
+
+        if (!pendingResponsesOnThread[thread].empty())
+        {
+            tlm_generic_payload& tPayload = *pendingResponsesOnThread[thread].front();
+            pendingResponsesOnThread[thread].pop();
+
+            sendResponse(tPayload, tCK);
+        }
+        else
+            threadIsBusy[thread] = false;
+    }
+    else if (cbPhase == REQ_ARBITRATION)
+    {
+        pendingRequestsOfThreadOnChannel[channel][thread].push(&cbTrans);
+
+        if (!channelIsBusy[channel])
+        {
+            channelIsBusy[channel] = true;
+
+            tlm_generic_payload& tPayload = *selectRequest(channel);
+            tlm_phase tPhase = BEGIN_REQ;
+            sc_time tDelay = lastEndReqOnChannel[channel] == sc_time_stamp() ? tCK : SC_ZERO_TIME;
+
+            iSocket[static_cast<int>(channel)]->nb_transport_fw(tPayload, tPhase, tDelay);
+        }
+    }
+    else if (cbPhase == RESP_ARBITRATION)
+    {
+        pendingResponsesOnThread[thread].push(&cbTrans);
+
+        if (!threadIsBusy[thread])
+        {
+            threadIsBusy[thread] = true;
+
+            tlm_generic_payload& tPayload = *pendingResponsesOnThread[thread].front();
+            pendingResponsesOnThread[thread].pop();
+
+            sendResponse(tPayload,
+                         lastEndRespOnThread[thread] == sc_time_stamp() ? tCK : SC_ZERO_TIME);
+        }
+    }
+    else
+        SC_REPORT_FATAL(0, "Payload event queue in arbiter was triggered with unknown phase");
+}
+
+tlm_generic_payload* ArbiterQoS::selectRequest(Channel channel)
+{
+    auto& pendingRequestsOfThread = pendingRequestsOfThreadOnChannel[channel];
+    auto& deficitOfThread = deficitOfThreadOnChannel[channel];
+    std::size_t numberOfThreads = tSocket.size();
+
+    // Requests that have already missed their deadline are served first, the earliest one first.
+    // Otherwise, only the threads of the highest pending priority class take part.
+    std::optional<Thread> urgentThread;
+    std::optional<unsigned int> highestPriority;
+
+    for (std::size_t id = 0; id < numberOfThreads; id++)
+    {
+        auto thread = Thread(id);
+        if (pendingRequestsOfThread[thread].empty())
+            continue;
+
+        sc_time deadline = ArbiterExtension::getDeadline(*pendingRequestsOfThread[thread].front());
+        if (deadline <= sc_time_stamp() &&
+            (!urgentThread.has_value() ||
+             deadline <
+                 ArbiterExtension::getDeadline(*pendingRequestsOfThread[*urgentThread].front())))
+            urgentThread = thread;
+
+        highestPriority = std::max(highestPriority.value_or(0), qosOnThread[thread].priority);
+    }
+
+    if (!highestPriority.has_value())
+        return nullptr;
+
+    if (urgentThread.has_value())
+    {
+        tlm_generic_payload* payload = pendingRequestsOfThread[*urgentThread].front();
+        pendingRequestsOfThread[*urgentThread].pop();
+        return payload;
+    }
+
+    // Deficit round robin: a thread may send as long as its deficit covers the size of its next
+    // request. If no thread of the class can send, every thread with pending requests is credited
+    // with a quantum that is scaled by its weight.
+    unsigned int& roundRobinThread = roundRobinThreadOnChannel[channel];
+
+    while (true)
+    {
+        for (std::size_t offset = 0; offset < numberOfThreads; offset++)
+        {
+            auto thread = Thread((roundRobinThread + offset) % numberOfThreads);
+            auto& pendingRequests = pendingRequestsOfThread[thread];
+
+            if (pendingRequests.empty() || qosOnThread[thread].priority != *highestPriority)
+                continue;
+
+            tlm_generic_payload* payload = pendingRequests.front();
+            if (deficitOfThread[thread] < payload->get_data_length())
+                continue;
+
+            deficitOfThread[thread] -= payload->get_data_length();
+            pendingRequests.pop();
+
+            if (pendingRequests.empty())
+                deficitOfThread[thread] = 0;
+
+            // Stay with the thread as long as it can send, otherwise continue with the next one.
+            bool canSendNext =
+                !pendingRequests.empty() &&
+                deficitOfThread[thread] >= pendingRequests.front()->get_data_length();
+            roundRobinThread = (static_cast<unsigned int>(thread) + (canSendNext ? 0 : 1)) %
+                               static_cast<unsigned int>(numberOfThreads);
+            return payload;
+        }
+
+        for (std::size_t id = 0; id < numberOfThreads; id++)
+        {
+            auto thread = Thread(id);
+            if (!pendingRequestsOfThread[thread].empty() &&
+                qosOnThread[thread].priority == *highestPriority)
+                deficitOfThread[thread] += std::uint64_t(qosOnThread[thread].weight) * quantum;
+        }
+    }
+}
+
+void ArbiterQoS::sendResponse(tlm_generic_payload& payload, const sc_time& delay)
+{
+    Thread thread = ArbiterExtension::getThread(payload);
+
+    responsesOnThread[thread]++;
+    if (sc_time_stamp() + delay > ArbiterExtension::getDeadline(payload))
+        deadlineMissesOnThread[thread]++;
+
+    tlm_phase tPhase = BEGIN_RESP;
+    sc_time tDelay = delay;
+
+    tlm_sync_enum returnValue =
+        tSocket[static_cast<int>(thread)]->nb_transport_bw(payload, tPhase, tDelay);
+    // Early completion from initiator
+    if (returnValue == TLM_UPDATED)
+        payloadEventQueue.notify(payload, tPhase, tDelay);
+}
+
+ArbiterReorder::ReorderWindow::ReorderWindow(std::size_t size) :
+    slots(std::max<std::size_t>(size, 1))
+{
+}
+
+void ArbiterReorder::ReorderWindow::insert(tlm_generic_payload& payload)
+{
+    std::uint64_t threadPayloadID = ArbiterExtension::getThreadPayloadID(payload);
+    assert(threadPayloadID >= nextThreadPayloadID);
+
+    // The window only has to grow if more transactions than expected are in flight.
+    std::uint64_t distance = threadPayloadID - nextThreadPayloadID;
+    if (distance >= slots.size())
+    {
+        std::vector<tlm_generic_payload*> grownSlots(distance + 1, nullptr);
+        for (std::uint64_t id = nextThreadPayloadID; id < nextThreadPayloadID + slots.size(); id++)
+            grownSlots[id % grownSlots.size()] = slots[id % slots.size()];
+        slots = std::move(grownSlots);
+    }
+
+    slots[threadPayloadID % slots.size()] = &payload;
+}
+
+tlm_generic_payload* ArbiterReorder::ReorderWindow::next() const
+{
+    return slots[nextThreadPayloadID % slots.size()];
+}
+
+void ArbiterReorder::ReorderWindow::pop()
+{
+    slots[nextThreadPayloadID % slots.size()] = nullptr;
+    nextThreadPayloadID++;
+}
+
 } // namespace DRAMSys
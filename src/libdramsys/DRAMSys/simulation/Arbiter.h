@@ -40,6 +40,7 @@
 #ifndef ARBITER_H
 #define ARBITER_H
 
+#include "DRAMSys/common/PayloadEventQueue.h"
 #include "DRAMSys/common/dramExtensions.h"
 #include "DRAMSys/controller/McConfig.h"
 #include "DRAMSys/simulation/AddressDecoder.h"
@@ -47,12 +48,10 @@
 
 #include <iostream>
 #include <queue>
-#include <set>
 #include <systemc>
 #include <tlm>
 #include <tlm_utils/multi_passthrough_initiator_socket.h>
 #include <tlm_utils/multi_passthrough_target_socket.h>
-#include <tlm_utils/peq_with_cb_and_phase.h>
 #include <vector>
 
 namespace DRAMSys
@@ -61,6 +60,17 @@ namespace DRAMSys
 DECLARE_EXTENDED_PHASE(REQ_ARBITRATION);
 DECLARE_EXTENDED_PHASE(RESP_ARBITRATION);
 
+// Quality of service settings of one initiator (thread) of the arbiter.
+struct ThreadQoS
+{
+    // Requests of a higher priority class are always arbitrated first.
+    unsigned int priority = 0;
+    // Share of the channel bandwidth relative to the other threads of the same priority class.
+    unsigned int weight = 1;
+    // Maximum latency of a request, zero if the thread has no deadline.
+    sc_core::sc_time deadline = sc_core::SC_ZERO_TIME;
+};
+
 class Arbiter : public sc_core::sc_module
 {
 public:
@@ -72,16 +82,21 @@ protected:
             const SimConfig& simConfig,
             const McConfig& mcConfig,
             const MemSpec& memSpec,
-            const AddressDecoder& addressDecoder);
+            const AddressDecoder& addressDecoder,
+            std::vector<ThreadQoS> threadQoS);
     SC_HAS_PROCESS(Arbiter);
 
     void end_of_elaboration() override;
 
     const AddressDecoder& addressDecoder;
 
-    tlm_utils::peq_with_cb_and_phase<Arbiter> payloadEventQueue;
+    PayloadEventQueue<Arbiter> payloadEventQueue;
     virtual void peqCallback(tlm::tlm_generic_payload& payload, const tlm::tlm_phase& phase) = 0;
 
+    // Initiators without an entry in threadQoS use the default settings.
+    const std::vector<ThreadQoS> threadQoS;
+    ControllerVector<Thread, ThreadQoS> qosOnThread;
+
     ControllerVector<Thread, bool> threadIsBusy;
     ControllerVector<Channel, bool> channelIsBusy;
 
@@ -116,7 +131,8 @@ public:
                   const SimConfig& simConfig,
                   const McConfig& mcConfig,
                   const MemSpec& memSpec,
-                  const AddressDecoder& addressDecoder);
+                  const AddressDecoder& addressDecoder,
+                  std::vector<ThreadQoS> threadQoS);
     SC_HAS_PROCESS(ArbiterSimple);
 
 private:
@@ -133,7 +149,8 @@ public:
                 const SimConfig& simConfig,
                 const McConfig& mcConfig,
                 const MemSpec& memSpec,
-                const AddressDecoder& addressDecoder);
+                const AddressDecoder& addressDecoder,
+                std::vector<ThreadQoS> threadQoS);
     SC_HAS_PROCESS(ArbiterFifo);
 
 private:
@@ -157,7 +174,8 @@ public:
                    const SimConfig& simConfig,
                    const McConfig& mcConfig,
                    const MemSpec& memSpec,
-                   const AddressDecoder& addressDecoder);
+                   const AddressDecoder& addressDecoder,
+                   std::vector<ThreadQoS> threadQoS);
     SC_HAS_PROCESS(ArbiterReorder);
 
 private:
@@ -167,24 +185,72 @@ private:
     ControllerVector<Thread, unsigned int> activeTransactionsOnThread;
     const unsigned maxActiveTransactions;
 
-    struct ThreadPayloadIDCompare
+    // Responses of one thread that wait to be returned in the order of their thread payload IDs.
+    // At most maxActiveTransactions IDs are in flight per thread, so the IDs are mapped onto a ring
+    // buffer of that size.
+    class ReorderWindow
     {
-        bool operator()(const tlm::tlm_generic_payload* lhs,
-                        const tlm::tlm_generic_payload* rhs) const
-        {
-            return ArbiterExtension::getThreadPayloadID(*lhs) <
-                   ArbiterExtension::getThreadPayloadID(*rhs);
-        }
+    public:
+        explicit ReorderWindow(std::size_t size = 1);
+
+        void insert(tlm::tlm_generic_payload& payload);
+        [[nodiscard]] tlm::tlm_generic_payload* next() const;
+        void pop();
+
+    private:
+        std::vector<tlm::tlm_generic_payload*> slots;
+        std::uint64_t nextThreadPayloadID = 1;
     };
 
     ControllerVector<Thread, tlm::tlm_generic_payload*> outstandingEndReqOnThread;
-    ControllerVector<Thread, std::set<tlm::tlm_generic_payload*, ThreadPayloadIDCompare>>
-        pendingResponsesOnThread;
+    ControllerVector<Thread, ReorderWindow> pendingResponsesOnThread;
+
+    ControllerVector<Channel, sc_core::sc_time> lastEndReqOnChannel;
+    ControllerVector<Thread, sc_core::sc_time> lastEndRespOnThread;
+};
+
+// Like ArbiterFifo, but requests of different threads to the same channel are arbitrated by their
+// quality of service settings: strict priority between the priority classes and deficit round
+// robin according to the weights within a class. Requests that have missed their deadline are
+// served first, earliest deadline first.
+class ArbiterQoS final : public Arbiter
+{
+public:
+    ArbiterQoS(const sc_core::sc_module_name& name,
+               const SimConfig& simConfig,
+               const McConfig& mcConfig,
+               const MemSpec& memSpec,
+               const AddressDecoder& addressDecoder,
+               std::vector<ThreadQoS> threadQoS);
+    SC_HAS_PROCESS(ArbiterQoS);
+
+private:
+    void end_of_elaboration() override;
+    void end_of_simulation() override;
+    void peqCallback(tlm::tlm_generic_payload& cbTrans, const tlm::tlm_phase& phase) override;
+
+    tlm::tlm_generic_payload* selectRequest(Channel channel);
+    void sendResponse(tlm::tlm_generic_payload& payload, const sc_core::sc_time& delay);
+
+    ControllerVector<Thread, unsigned int> activeTransactionsOnThread;
+    const unsigned maxActiveTransactionsPerThread;
+
+    // Number of bytes a thread of weight 1 may transfer per round
+    const unsigned quantum;
+
+    ControllerVector<Thread, tlm::tlm_generic_payload*> outstandingEndReqOnThread;
+    ControllerVector<Thread, std::queue<tlm::tlm_generic_payload*>> pendingResponsesOnThread;
+
+    ControllerVector<Channel, ControllerVector<Thread, std::queue<tlm::tlm_generic_payload*>>>
+        pendingRequestsOfThreadOnChannel;
+    ControllerVector<Channel, ControllerVector<Thread, std::uint64_t>> deficitOfThreadOnChannel;
+    ControllerVector<Channel, unsigned int> roundRobinThreadOnChannel;
 
     ControllerVector<Channel, sc_core::sc_time> lastEndReqOnChannel;
     ControllerVector<Thread, sc_core::sc_time> lastEndRespOnThread;
 
-    ControllerVector<Thread, std::uint64_t> nextThreadPayloadIDToReturn;
+    ControllerVector<Thread, std::uint64_t> responsesOnThread;
+    ControllerVector<Thread, std::uint64_t> deadlineMissesOnThread;
 };
 
 } // namespace DRAMSys
@@ -40,6 +40,7 @@
 
 #include "DRAMSys.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 #include "DRAMSys/common/utils.h"
 
@@ -65,11 +66,18 @@
 #endif
 
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <variant>
 #include <vector>
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 namespace DRAMSys
 {
 
@@ -79,7 +87,8 @@ DRAMSys::DRAMSys(const sc_core::sc_module_name& name, const Config::Configuratio
     simConfig(config.simconfig),
     mcConfig(config.mcconfig, *memSpec),
     addressDecoder(std::make_unique<AddressDecoder>(config.addressmapping)),
-    arbiter(createArbiter(simConfig, mcConfig, *memSpec, *addressDecoder))
+    arbiter(createArbiter(
+        simConfig, mcConfig, *memSpec, *addressDecoder, createThreadQoS(config.tracesetup)))
 {
     logo();
     addressDecoder->plausibilityCheck(*memSpec);
@@ -155,6 +164,23 @@ DRAMSys::DRAMSys(const sc_core::sc_module_name& name, const Config::Configuratio
         controllers[i]->iSocket.bind(drams[i]->tSocket);
     }
 
+    if (!simConfig.saveCheckpoint.empty())
+    {
+        checkpointPending = true;
+        SC_THREAD(checkpointThread);
+    }
+
+    // The sampler also takes care of an initial fast-forward period
+    if (simConfig.samplingInterval > 0)
+    {
+        sampler = std::make_unique<Sampler>("sampler", simConfig, *memSpec, controllers, drams);
+    }
+    else if (simConfig.fastForwardCycles > 0)
+    {
+        setFunctional(true);
+        SC_THREAD(fastForwardThread);
+    }
+
     report();
 }
 
@@ -202,8 +228,165 @@ void DRAMSys::registerIdleCallback(const std::function<void()>& idleCallback)
     }
 }
 
+void DRAMSys::saveCheckpoint(const std::string& path)
+{
+    if (!idle())
+        SC_REPORT_FATAL("DRAMSys", "Checkpoints can only be taken while all controllers are idle");
+
+#ifndef _WIN32
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        std::ofstream file(path, std::ios::binary);
+        serialize(file);
+        file.close();
+        std::_Exit(file ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    if (pid > 0)
+    {
+        checkpointWriters.push_back(pid);
+        return;
+    }
+
+    SC_REPORT_WARNING("DRAMSys", "Forking the checkpoint writer failed, writing synchronously");
+#endif
+
+    std::ofstream file(path, std::ios::binary);
+    serialize(file);
+
+    if (!file)
+        SC_REPORT_FATAL("DRAMSys", ("Could not write checkpoint " + path).c_str());
+}
+
+void DRAMSys::restoreCheckpoint(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        SC_REPORT_FATAL("DRAMSys", ("Could not open checkpoint " + path).c_str());
+
+    deserialize(file);
+}
+
+void DRAMSys::serialize(std::ostream& stream) const
+{
+    Checkpoint::write(stream,
+                      CHECKPOINT_MAGIC,
+                      CHECKPOINT_VERSION,
+                      static_cast<uint64_t>(memSpec->numberOfChannels));
+
+    for (std::size_t i = 0; i < memSpec->numberOfChannels; i++)
+    {
+        controllers[i]->serialize(stream);
+        drams[i]->serialize(stream);
+    }
+}
+
+void DRAMSys::deserialize(std::istream& stream)
+{
+    uint64_t magic = 0;
+    uint32_t version = 0;
+    uint64_t numberOfChannels = 0;
+    Checkpoint::read(stream, magic, version, numberOfChannels);
+
+    if (!stream || magic != CHECKPOINT_MAGIC)
+        SC_REPORT_FATAL("DRAMSys", "Not a DRAMSys checkpoint");
+
+    if (version != CHECKPOINT_VERSION)
+        SC_REPORT_FATAL("DRAMSys", "Unsupported checkpoint version");
+
+    if (numberOfChannels != memSpec->numberOfChannels)
+        SC_REPORT_FATAL("DRAMSys", "Checkpoint was taken with a different number of channels");
+
+    for (std::size_t i = 0; i < memSpec->numberOfChannels; i++)
+    {
+        controllers[i]->deserialize(stream);
+        drams[i]->deserialize(stream);
+    }
+}
+
+void DRAMSys::checkpointThread()
+{
+    sc_core::wait(static_cast<double>(simConfig.saveCheckpointCycle) * memSpec->tCK);
+
+    // The checkpoint is taken at the first clock cycle in which all controllers are idle
+    if (!idle())
+    {
+        SC_REPORT_WARNING("DRAMSys", "Postponing the checkpoint until all controllers are idle");
+
+        uint64_t postponedCycles = 0;
+        while (!idle())
+        {
+            if (postponedCycles == simConfig.saveCheckpointTimeout)
+            {
+                SC_REPORT_WARNING(
+                    "DRAMSys",
+                    ("Skipping the checkpoint, the controllers were not idle within " +
+                     std::to_string(simConfig.saveCheckpointTimeout) + " cycles")
+                        .c_str());
+                checkpointPending = false;
+                return;
+            }
+
+            sc_core::wait(memSpec->tCK);
+            postponedCycles++;
+        }
+    }
+
+    checkpointPending = false;
+    std::cout << name() << "  Saving checkpoint " << simConfig.saveCheckpoint << " at "
+              << sc_core::sc_time_stamp() << std::endl;
+    saveCheckpoint(simConfig.saveCheckpoint);
+}
+
+void DRAMSys::setFunctional(bool functional)
+{
+    for (auto& controller : controllers)
+        controller->setFunctional(functional);
+}
+
+bool DRAMSys::isFunctional() const
+{
+    return !controllers.empty() && controllers.front()->isFunctional();
+}
+
+void DRAMSys::fastForwardThread()
+{
+    sc_core::wait(static_cast<double>(simConfig.fastForwardCycles) * memSpec->tCK);
+
+    std::cout << name() << "  Switching from fast-forward to timing simulation at "
+              << sc_core::sc_time_stamp() << std::endl;
+    setFunctional(false);
+}
+
+void DRAMSys::waitForCheckpointWriters()
+{
+#ifndef _WIN32
+    for (int pid : checkpointWriters)
+    {
+        int status = 0;
+        if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) ||
+            WEXITSTATUS(status) != EXIT_SUCCESS)
+            SC_REPORT_WARNING("DRAMSys", "Writing a checkpoint failed");
+    }
+#endif
+
+    checkpointWriters.clear();
+}
+
+void DRAMSys::start_of_simulation()
+{
+    if (!simConfig.restoreCheckpoint.empty())
+        restoreCheckpoint(simConfig.restoreCheckpoint);
+}
+
 void DRAMSys::end_of_simulation()
 {
+    if (checkpointPending)
+        SC_REPORT_WARNING("DRAMSys", "The simulation ended before the checkpoint was taken");
+
+    waitForCheckpointWriters();
+
     if (simConfig.powerAnalysis)
     {
         for (auto& dram : drams)
@@ -310,22 +493,57 @@ std::unique_ptr<const MemSpec> DRAMSys::createMemSpec(const Config::MemSpec& mem
 std::unique_ptr<Arbiter> DRAMSys::createArbiter(const SimConfig& simConfig,
                                                 const McConfig& mcConfig,
                                                 const MemSpec& memSpec,
-                                                const AddressDecoder& addressDecoder)
+                                                const AddressDecoder& addressDecoder,
+                                                std::vector<ThreadQoS> threadQoS)
 {
     if (mcConfig.arbiter == Config::ArbiterType::Simple)
         return std::make_unique<ArbiterSimple>(
-            "arbiter", simConfig, mcConfig, memSpec, addressDecoder);
+            "arbiter", simConfig, mcConfig, memSpec, addressDecoder, std::move(threadQoS));
 
     if (mcConfig.arbiter == Config::ArbiterType::Fifo)
         return std::make_unique<ArbiterFifo>(
-            "arbiter", simConfig, mcConfig, memSpec, addressDecoder);
+            "arbiter", simConfig, mcConfig, memSpec, addressDecoder, std::move(threadQoS));
 
     if (mcConfig.arbiter == Config::ArbiterType::Reorder)
         return std::make_unique<ArbiterReorder>(
-            "arbiter", simConfig, mcConfig, memSpec, addressDecoder);
+            "arbiter", simConfig, mcConfig, memSpec, addressDecoder, std::move(threadQoS));
+
+    if (mcConfig.arbiter == Config::ArbiterType::QoS)
+        return std::make_unique<ArbiterQoS>(
+            "arbiter", simConfig, mcConfig, memSpec, addressDecoder, std::move(threadQoS));
 
     SC_REPORT_FATAL("DRAMSys", "Invalid Arbiter");
     return {};
 }
 
+std::vector<ThreadQoS>
+DRAMSys::createThreadQoS(const std::optional<std::vector<Config::Initiator>>& traceSetup)
+{
+    // The initiators are bound to the arbiter in the order of the trace setup.
+    std::vector<ThreadQoS> threadQoS;
+    if (!traceSetup.has_value())
+        return threadQoS;
+
+    for (const auto& initiator : *traceSetup)
+    {
+        std::visit(
+            [&threadQoS](auto&& config)
+            {
+                ThreadQoS qos;
+                qos.priority = config.priority.value_or(qos.priority);
+                qos.weight = config.weight.value_or(qos.weight);
+                if (config.deadline.has_value())
+                    qos.deadline = sc_core::sc_time(*config.deadline, sc_core::SC_NS);
+
+                if (qos.weight == 0)
+                    SC_REPORT_FATAL("DRAMSys", "The weight of an initiator must be at least 1");
+
+                threadQoS.push_back(qos);
+            },
+            initiator);
+    }
+
+    return threadQoS;
+}
+
 } // namespace DRAMSys
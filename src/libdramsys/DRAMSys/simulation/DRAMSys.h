@@ -41,6 +41,8 @@
 #ifndef DRAMSYS_H
 #define DRAMSYS_H
 
+#include "DRAMSys/common/Deserialize.h"
+#include "DRAMSys/common/Serialize.h"
 #include "DRAMSys/common/TlmRecorder.h"
 #include "DRAMSys/common/tlm2_base_protocol_checker.h"
 #include "DRAMSys/config/DRAMSysConfiguration.h"
@@ -51,20 +53,23 @@
 #include "DRAMSys/simulation/Arbiter.h"
 #include "DRAMSys/simulation/Dram.h"
 #include "DRAMSys/simulation/DramRecordable.h"
+#include "DRAMSys/simulation/Sampler.h"
 #include "DRAMSys/simulation/SimConfig.h"
 
 #include <list>
 #include <memory>
+#include <optional>
 #include <string>
 #include <systemc>
 #include <tlm>
 #include <tlm_utils/multi_passthrough_initiator_socket.h>
 #include <tlm_utils/multi_passthrough_target_socket.h>
+#include <vector>
 
 namespace DRAMSys
 {
 
-class DRAMSys : public sc_core::sc_module
+class DRAMSys : public sc_core::sc_module, public Serialize, public Deserialize
 {
 public:
     tlm_utils::multi_passthrough_target_socket<DRAMSys> tSocket{"DRAMSys_tSocket"};
@@ -88,16 +93,49 @@ public:
      */
     void registerIdleCallback(const std::function<void()>& idleCallback);
 
+    /**
+     * Writes the state of all memory controllers and the memory contents to a checkpoint file.
+     * All memory controllers have to be idle. Where fork() is available, the file is written by
+     * a child process from its copy-on-write snapshot, so the simulation continues immediately.
+     */
+    void saveCheckpoint(const std::string& path);
+
+    /**
+     * Restores a checkpoint into a simulation with the same memory geometry. Components whose
+     * implementation differs from the checkpointed configuration keep their initial state.
+     */
+    void restoreCheckpoint(const std::string& path);
+
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+
+    /**
+     * Switches all memory controllers between functional fast-forwarding and cycle-accurate
+     * timing. In functional mode requests access the storage directly and are answered after
+     * the fixed blocking read/write delay, while refresh keeps running in the background so
+     * that the refresh timers are aligned when timing is switched on again.
+     */
+    void setFunctional(bool functional);
+    [[nodiscard]] bool isFunctional() const;
+
 private:
     static void logo();
     static std::unique_ptr<const MemSpec> createMemSpec(const Config::MemSpec& memSpec);
     static std::unique_ptr<Arbiter> createArbiter(const SimConfig& simConfig,
                                                   const McConfig& mcConfig,
                                                   const MemSpec& memSpec,
-                                                  const AddressDecoder& addressDecoder);
+                                                  const AddressDecoder& addressDecoder,
+                                                  std::vector<ThreadQoS> threadQoS);
+    static std::vector<ThreadQoS>
+    createThreadQoS(const std::optional<std::vector<Config::Initiator>>& traceSetup);
 
+    void start_of_simulation() override;
     void end_of_simulation() override;
 
+    void checkpointThread();
+    void fastForwardThread();
+    void waitForCheckpointWriters();
+
     void setupDebugManager(const std::string& traceName) const;
     void setupTlmRecorders(const std::string& traceName, const Config::Configuration& configLib);
 
@@ -121,9 +159,21 @@ private:
     // DRAM units
     std::vector<std::unique_ptr<Dram>> drams;
 
+    // Alternates functional and detailed simulation if sampling is enabled
+    std::unique_ptr<Sampler> sampler;
+
     // Transaction Recorders (one per channel).
     // They generate the output databases.
     std::vector<TlmRecorder> tlmRecorders;
+
+    // Child processes that are still writing checkpoints
+    std::vector<int> checkpointWriters;
+
+    // A checkpoint was requested but has not been taken or skipped yet
+    bool checkpointPending = false;
+
+    static constexpr uint64_t CHECKPOINT_MAGIC = 0x54504b4353595344; // "DSYSCKPT"
+    static constexpr uint32_t CHECKPOINT_VERSION = 3;
 };
 
 } // namespace DRAMSys
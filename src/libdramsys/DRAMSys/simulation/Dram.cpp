@@ -40,6 +40,7 @@
 
 #include "Dram.h"
 
+#include "DRAMSys/common/Checkpoint.h"
 #include "DRAMSys/common/DebugManager.h"
 #include "DRAMSys/config/SimConfig.h"
 
@@ -49,13 +50,6 @@
 
 #include <cassert>
 #include <cstdint>
-#include <cstdlib>
-
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <sys/mman.h>
-#endif
 
 using namespace sc_core;
 using namespace tlm;
@@ -72,32 +66,12 @@ Dram::Dram(const sc_module_name& name, const SimConfig& simConfig, const MemSpec
     memSpec(memSpec),
     storeMode(simConfig.storeMode),
     powerAnalysis(simConfig.powerAnalysis),
-    channelSize(memSpec.getSimMemSizeInBytes() / memSpec.numberOfChannels),
-    useMalloc(simConfig.useMalloc)
+    channelSize(memSpec.getSimMemSizeInBytes() / memSpec.numberOfChannels)
 {
     if (storeMode == Config::StoreModeType::Store)
     {
-        if (useMalloc)
-        {
-            memory = (unsigned char*)malloc(channelSize);
-            if (memory == nullptr)
-                SC_REPORT_FATAL(this->name(), "Memory allocation failed");
-        }
-        else
-        {
-// allocate and model storage of one DRAM channel using memory map
-#ifdef _WIN32
-            SC_REPORT_FATAL("Dram", "On Windows Storage is not yet supported");
-            memory = 0; // FIXME
-#else
-            memory = (unsigned char*)mmap(nullptr,
-                                          channelSize,
-                                          PROT_READ | PROT_WRITE,
-                                          MAP_PRIVATE | MAP_ANON | MAP_NORESERVE,
-                                          -1,
-                                          0);
-#endif
-        }
+        memory = std::make_unique<SparseMemory>(
+            channelSize, simConfig.storeFillPattern, simConfig.useMalloc);
     }
 
     tSocket.register_nb_transport_fw(this, &Dram::nb_transport_fw);
@@ -112,11 +86,7 @@ Dram::Dram(const sc_module_name& name, const SimConfig& simConfig, const MemSpec
 #endif
 }
 
-Dram::~Dram()
-{
-    if (useMalloc)
-        free(memory);
-}
+Dram::~Dram() = default;
 
 void Dram::reportPower()
 {
@@ -135,6 +105,33 @@ void Dram::reportPower()
 #endif
 }
 
+double Dram::getEnergy()
+{
+#ifdef DRAMPOWER
+    if (powerAnalysis)
+    {
+        calcWindowEnergy();
+        return accumulatedEnergy;
+    }
+#endif
+    return 0.0;
+}
+
+#ifdef DRAMPOWER
+void Dram::calcWindowEnergy()
+{
+    int64_t clkCycles = std::lround(sc_time_stamp() / memSpec.tCK);
+
+    // An empty window would reset the window energy of the last one
+    if (clkCycles == lastWindowCycle)
+        return;
+
+    DRAMPower->calcWindowEnergy(clkCycles);
+    accumulatedEnergy += DRAMPower->getEnergy().window_energy * memSpec.devicesPerRank;
+    lastWindowCycle = clkCycles;
+}
+#endif
+
 tlm_sync_enum Dram::nb_transport_fw(tlm_generic_payload& trans, tlm_phase& phase, sc_time& delay)
 {
     assert(phase >= BEGIN_RD && phase <= END_SREF);
@@ -192,14 +189,6 @@ unsigned int Dram::transport_dbg(tlm_generic_payload& trans)
 
 void Dram::b_transport(tlm_generic_payload& trans, [[maybe_unused]] sc_time& delay)
 {
-    static bool printedWarning = false;
-
-    if (!printedWarning)
-    {
-        SC_REPORT_WARNING("DRAM", BLOCKING_WARNING.data());
-        printedWarning = true;
-    }
-
     if (storeMode == Config::StoreModeType::Store)
     {
         if (trans.is_read())
@@ -217,54 +206,41 @@ void Dram::b_transport(tlm_generic_payload& trans, [[maybe_unused]] sc_time& del
 
 void Dram::executeRead(tlm::tlm_generic_payload& trans) const
 {
-    unsigned char* phyAddr = memory + trans.get_address();
-
-    if (trans.get_byte_enable_ptr() == nullptr)
-    {
-        memcpy(trans.get_data_ptr(), phyAddr, trans.get_data_length());
-    }
-    else
-    {
-        for (std::size_t i = 0; i < trans.get_data_length(); i++)
-        {
-            std::size_t byteEnableIndex = i % trans.get_byte_enable_length();
-            if (trans.get_byte_enable_ptr()[byteEnableIndex] == TLM_BYTE_ENABLED)
-            {
-                trans.get_data_ptr()[i] = phyAddr[i];
-            }
-        }
-    }
+    memory->read(trans.get_address(),
+                 trans.get_data_ptr(),
+                 trans.get_data_length(),
+                 trans.get_byte_enable_ptr(),
+                 trans.get_byte_enable_length());
 }
 
 void Dram::executeWrite(const tlm::tlm_generic_payload& trans)
 {
-    unsigned char* phyAddr = memory + trans.get_address();
-
-    if (trans.get_byte_enable_ptr() == nullptr)
-    {
-        memcpy(phyAddr, trans.get_data_ptr(), trans.get_data_length());
-    }
-    else
-    {
-        for (std::size_t i = 0; i < trans.get_data_length(); i++)
-        {
-            std::size_t byteEnableIndex = i % trans.get_byte_enable_length();
-            if (trans.get_byte_enable_ptr()[byteEnableIndex] == TLM_BYTE_ENABLED)
-            {
-                phyAddr[i] = trans.get_data_ptr()[i];
-            }
-        }
-    }
+    memory->write(trans.get_address(),
+                  trans.get_data_ptr(),
+                  trans.get_data_length(),
+                  trans.get_byte_enable_ptr(),
+                  trans.get_byte_enable_length());
 }
 
 void Dram::serialize(std::ostream& stream) const
 {
-    stream.write(reinterpret_cast<char const*>(memory), channelSize);
+    bool stored = memory != nullptr;
+    Checkpoint::write(stream, stored);
+
+    if (stored)
+        Checkpoint::writeSection(stream, "Memory", *memory);
 }
 
 void Dram::deserialize(std::istream& stream)
 {
-    stream.read(reinterpret_cast<char*>(memory), channelSize);
+    bool stored = false;
+    Checkpoint::read(stream, stored);
+
+    // Memory contents are dropped when restoring into a configuration without storage
+    if (stored && memory != nullptr)
+        Checkpoint::readSection(stream, "Memory", *memory);
+    else if (stored)
+        Checkpoint::skipSection(stream);
 }
 
 } // namespace DRAMSys
@@ -45,6 +45,7 @@
 #include "DRAMSys/common/Serialize.h"
 #include "DRAMSys/configuration/memspec/MemSpec.h"
 #include "DRAMSys/simulation/SimConfig.h"
+#include "DRAMSys/simulation/SparseMemory.h"
 
 #include <memory>
 #include <systemc>
@@ -64,12 +65,16 @@ protected:
     // Data Storage:
     const Config::StoreModeType storeMode;
     const bool powerAnalysis;
-    unsigned char* memory;
     const uint64_t channelSize;
-    const bool useMalloc;
+    std::unique_ptr<SparseMemory> memory;
 
 #ifdef DRAMPOWER
     std::unique_ptr<libDRAMPower> DRAMPower;
+
+    // Closes the current DRAMPower window at the current clock cycle
+    void calcWindowEnergy();
+    double accumulatedEnergy = 0.0;
+    int64_t lastWindowCycle = 0;
 #endif
 
     virtual tlm::tlm_sync_enum nb_transport_fw(tlm::tlm_generic_payload& trans,
@@ -91,14 +96,13 @@ public:
     Dram& operator=(Dram&&) = delete;
     ~Dram() override;
 
-    static constexpr std::string_view BLOCKING_WARNING =
-        "Use the blocking mode of DRAMSys with caution! "
-        "The simulated timings do not reflect the real system!";
-
     tlm_utils::simple_target_socket<Dram> tSocket{"tSocket"};
 
     virtual void reportPower();
 
+    // Energy in pJ consumed up to the current simulation time, 0 without power analysis
+    double getEnergy();
+
     void serialize(std::ostream& stream) const override;
     void deserialize(std::istream& stream) override;
 };
@@ -63,12 +63,10 @@ DramRecordable::DramRecordable(const sc_module_name& name,
 
 void DramRecordable::reportPower()
 {
-    Dram::reportPower();
 #ifdef DRAMPOWER
-    tlmRecorder.recordPower(sc_time_stamp().to_seconds(),
-                            this->DRAMPower->getPower().window_average_power *
-                                this->memSpec.devicesPerRank);
+    recordWindowPower();
 #endif
+    Dram::reportPower();
 }
 
 tlm_sync_enum
@@ -84,38 +82,43 @@ DramRecordable::nb_transport_fw(tlm_generic_payload& trans, tlm_phase& phase, sc
 // visualization purposes.
 void DramRecordable::powerWindow()
 {
-    int64_t clkCycles = 0;
-
     while (true)
     {
         // At the very beginning (zero clock cycles) the energy is 0, so we wait first
         sc_module::wait(powerWindowSize);
 
-        clkCycles = std::lround(sc_time_stamp() / this->memSpec.tCK);
-
-        this->DRAMPower->calcWindowEnergy(clkCycles);
-
-        // During operation the energy should never be zero since the device is always consuming
-        assert(!isEqual(this->DRAMPower->getEnergy().window_energy, 0.0));
-
-        // Store the time (in seconds) and the current average power (in mW) into the database
-        tlmRecorder.recordPower(sc_time_stamp().to_seconds(),
-                                this->DRAMPower->getPower().window_average_power *
-                                    this->memSpec.devicesPerRank);
-
-        // Here considering that DRAMPower provides the energy in pJ and the power in mW
-        PRINTDEBUGMESSAGE(this->name(),
-                          std::string("\tWindow Energy: \t") +
-                              std::to_string(this->DRAMPower->getEnergy().window_energy *
-                                             this->memSpec.devicesPerRank) +
-                              std::string("\t[pJ]"));
-        PRINTDEBUGMESSAGE(this->name(),
-                          std::string("\tWindow Average Power: \t") +
-                              std::to_string(this->DRAMPower->getPower().window_average_power *
-                                             this->memSpec.devicesPerRank) +
-                              std::string("\t[mW]"));
+        recordWindowPower();
     }
 }
+
+void DramRecordable::recordWindowPower()
+{
+    sc_time windowLength = sc_time_stamp() - windowStartTime;
+    if (windowLength == SC_ZERO_TIME)
+        return;
+
+    double energy = getEnergy();
+    double windowEnergy = energy - windowStartEnergy;
+
+    // During operation the energy should never be zero since the device is always consuming
+    assert(!isEqual(windowEnergy, 0.0));
+
+    // Energy in pJ per time in ns gives the power in mW
+    double windowPower = windowEnergy / (windowLength / sc_time(1, SC_NS));
+
+    // Store the time (in seconds) and the current average power (in mW) into the database
+    tlmRecorder.recordPower(sc_time_stamp().to_seconds(), windowPower);
+
+    PRINTDEBUGMESSAGE(this->name(),
+                      std::string("\tWindow Energy: \t") + std::to_string(windowEnergy) +
+                          std::string("\t[pJ]"));
+    PRINTDEBUGMESSAGE(this->name(),
+                      std::string("\tWindow Average Power: \t") + std::to_string(windowPower) +
+                          std::string("\t[mW]"));
+
+    windowStartTime = sc_time_stamp();
+    windowStartEnergy = energy;
+}
 #endif
 
 } // namespace DRAMSys
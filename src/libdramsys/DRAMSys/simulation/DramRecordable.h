@@ -82,6 +82,13 @@ private:
     // It estimates the current average power which will be stored in the trace database for
     // visualization purposes.
     void powerWindow();
+
+    // Records the average power since the last recorded window. The power is derived from the
+    // accumulated energy of the DRAM because other modules (e.g. the sampler) may close DRAMPower
+    // windows in between.
+    void recordWindowPower();
+    sc_core::sc_time windowStartTime;
+    double windowStartEnergy = 0.0;
 #endif
 };
 
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sampler.h"
+
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+using namespace sc_core;
+
+namespace DRAMSys
+{
+
+Sampler::Sampler(const sc_module_name& name,
+                 const SimConfig& simConfig,
+                 const MemSpec& memSpec,
+                 const std::vector<std::unique_ptr<Controller>>& controllers,
+                 const std::vector<std::unique_ptr<Dram>>& drams) :
+    sc_module(name),
+    memSpec(memSpec),
+    powerAnalysis(simConfig.powerAnalysis),
+    fastForwardCycles(simConfig.fastForwardCycles),
+    functionalTime(static_cast<double>(simConfig.samplingInterval - simConfig.samplingWarmup -
+                                       simConfig.samplingWindow) *
+                   memSpec.tCK),
+    warmupTime(static_cast<double>(simConfig.samplingWarmup) * memSpec.tCK),
+    windowTime(static_cast<double>(simConfig.samplingWindow) * memSpec.tCK),
+    controllers(controllers),
+    drams(drams),
+    windowStart(controllers.size()),
+    statistics(controllers.size())
+{
+    SC_THREAD(samplingThread);
+}
+
+void Sampler::samplingThread()
+{
+    if (fastForwardCycles > 0)
+    {
+        setFunctional(true);
+        wait(static_cast<double>(fastForwardCycles) * memSpec.tCK);
+    }
+
+    while (true)
+    {
+        if (functionalTime > SC_ZERO_TIME)
+        {
+            setFunctional(true);
+            wait(functionalTime);
+        }
+
+        // The scheduler queues start empty, requests issued in functional mode drain during the
+        // warmup
+        setFunctional(false);
+        wait(warmupTime);
+
+        for (std::size_t channel = 0; channel < controllers.size(); channel++)
+            windowStart[channel] = takeSnapshot(channel);
+
+        wait(windowTime);
+
+        double windowNs = windowTime.to_seconds() * 1e9;
+
+        for (std::size_t channel = 0; channel < controllers.size(); channel++)
+        {
+            Snapshot windowEnd = takeSnapshot(channel);
+            const Snapshot& start = windowStart[channel];
+            ChannelStatistics& channelStatistics = statistics[channel];
+
+            channelStatistics.bandwidth.add(
+                static_cast<double>((windowEnd.beats - start.beats) * memSpec.bytesPerBeat) /
+                windowNs);
+
+            // Windows without any completed request carry no latency information
+            uint64_t payloads = windowEnd.payloads - start.payloads;
+            if (payloads > 0)
+            {
+                sc_time residenceTime = windowEnd.residenceTime - start.residenceTime;
+                channelStatistics.latency.add(residenceTime.to_seconds() * 1e9 /
+                                              static_cast<double>(payloads));
+            }
+
+            // Energy in pJ per time in ns gives the power in mW
+            if (powerAnalysis)
+                channelStatistics.power.add((windowEnd.energy - start.energy) / windowNs);
+        }
+    }
+}
+
+void Sampler::setFunctional(bool functional)
+{
+    for (const auto& controller : controllers)
+        controller->setFunctional(functional);
+}
+
+Sampler::Snapshot Sampler::takeSnapshot(std::size_t channel) const
+{
+    Snapshot snapshot;
+    snapshot.beats = controllers[channel]->getNumberOfBeatsServed();
+    snapshot.payloads = controllers[channel]->getNumberOfPayloadsServed();
+    snapshot.residenceTime = controllers[channel]->getPayloadResidenceTime();
+    snapshot.energy = drams[channel]->getEnergy();
+    return snapshot;
+}
+
+void Sampler::Statistic::add(double sample)
+{
+    // Welford's online algorithm
+    numberOfSamples++;
+    double delta = sample - average;
+    average += delta / static_cast<double>(numberOfSamples);
+    sumOfSquares += delta * (sample - average);
+}
+
+double Sampler::Statistic::confidenceHalfWidth() const
+{
+    // Two-sided 95 % quantiles of Student's t-distribution for 1 to 30 degrees of freedom
+    static constexpr std::array<double, 30> T_QUANTILES = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    static constexpr double Z_QUANTILE = 1.960;
+
+    if (numberOfSamples < 2)
+        return std::numeric_limits<double>::infinity();
+
+    uint64_t degreesOfFreedom = numberOfSamples - 1;
+    double quantile =
+        degreesOfFreedom <= T_QUANTILES.size() ? T_QUANTILES[degreesOfFreedom - 1] : Z_QUANTILE;
+    double variance = sumOfSquares / static_cast<double>(degreesOfFreedom);
+    return quantile * std::sqrt(variance / static_cast<double>(numberOfSamples));
+}
+
+void Sampler::end_of_simulation()
+{
+    auto print = [](const std::string& prefix,
+                    const std::string& label,
+                    const Statistic& statistic,
+                    const std::string& unit)
+    {
+        if (statistic.count() == 0)
+            return;
+
+        double halfWidth = statistic.confidenceHalfWidth();
+        std::cout << prefix << label << std::fixed << std::setprecision(2) << std::setw(8)
+                  << statistic.mean() << " " << unit << " +- " << halfWidth << " " << unit;
+        if (statistic.mean() != 0.0 && std::isfinite(halfWidth))
+            std::cout << " (" << halfWidth / statistic.mean() * 100 << " %)";
+        std::cout << std::endl;
+    };
+
+    for (std::size_t channel = 0; channel < controllers.size(); channel++)
+    {
+        const ChannelStatistics& channelStatistics = statistics[channel];
+        std::string prefix = controllers[channel]->name();
+
+        std::cout << prefix << "  Sampled windows: " << channelStatistics.bandwidth.count()
+                  << " (95 % confidence intervals)" << std::endl;
+        print(prefix, "  Sampled AVG BW:      ", channelStatistics.bandwidth, "GB/s");
+        print(prefix, "  Sampled AVG latency: ", channelStatistics.latency, "ns");
+        print(drams[channel]->name(), "  Sampled AVG power:   ", channelStatistics.power, "mW");
+    }
+}
+
+} // namespace DRAMSys
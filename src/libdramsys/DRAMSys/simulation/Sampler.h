@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include "DRAMSys/configuration/memspec/MemSpec.h"
+#include "DRAMSys/controller/Controller.h"
+#include "DRAMSys/simulation/Dram.h"
+#include "DRAMSys/simulation/SimConfig.h"
+
+#include <memory>
+#include <systemc>
+#include <vector>
+
+namespace DRAMSys
+{
+
+/**
+ * Systematic sampling in the style of SMARTS: each sampling interval starts with a functional
+ * fast-forward period, followed by a detailed warmup and a detailed measurement window. The
+ * averages of the measurement windows are extrapolated to the whole simulation and reported
+ * together with their 95 % confidence intervals.
+ */
+class Sampler : public sc_core::sc_module
+{
+public:
+    Sampler(const sc_core::sc_module_name& name,
+            const SimConfig& simConfig,
+            const MemSpec& memSpec,
+            const std::vector<std::unique_ptr<Controller>>& controllers,
+            const std::vector<std::unique_ptr<Dram>>& drams);
+    SC_HAS_PROCESS(Sampler);
+
+private:
+    class Statistic
+    {
+    public:
+        void add(double sample);
+        [[nodiscard]] uint64_t count() const { return numberOfSamples; }
+        [[nodiscard]] double mean() const { return average; }
+        [[nodiscard]] double confidenceHalfWidth() const;
+
+    private:
+        uint64_t numberOfSamples = 0;
+        double average = 0.0;
+        double sumOfSquares = 0.0;
+    };
+
+    struct Snapshot
+    {
+        uint64_t beats = 0;
+        uint64_t payloads = 0;
+        sc_core::sc_time residenceTime;
+        double energy = 0.0;
+    };
+
+    struct ChannelStatistics
+    {
+        Statistic bandwidth; // GB/s
+        Statistic latency;   // ns
+        Statistic power;     // mW
+    };
+
+    void samplingThread();
+    void setFunctional(bool functional);
+    Snapshot takeSnapshot(std::size_t channel) const;
+    void end_of_simulation() override;
+
+    const MemSpec& memSpec;
+    const bool powerAnalysis;
+    const uint64_t fastForwardCycles;
+    const sc_core::sc_time functionalTime;
+    const sc_core::sc_time warmupTime;
+    const sc_core::sc_time windowTime;
+
+    const std::vector<std::unique_ptr<Controller>>& controllers;
+    const std::vector<std::unique_ptr<Dram>>& drams;
+
+    std::vector<Snapshot> windowStart;
+    std::vector<ChannelStatistics> statistics;
+};
+
+} // namespace DRAMSys
+
+#endif // SAMPLER_H
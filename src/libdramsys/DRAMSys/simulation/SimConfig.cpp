@@ -53,14 +53,38 @@ SimConfig::SimConfig(const Config::SimConfig& simConfig) :
     checkTLM2Protocol(simConfig.CheckTLM2Protocol.value_or(DEFAULT_CHECK_TLM2_PROTOCOL)),
     useMalloc(simConfig.UseMalloc.value_or(DEFAULT_USE_MALLOC)),
     addressOffset(simConfig.AddressOffset.value_or(DEFAULT_ADDRESS_OFFSET)),
-    storeMode(simConfig.StoreMode.value_or(DEFAULT_STORE_MODE))
+    storeMode(simConfig.StoreMode.value_or(DEFAULT_STORE_MODE)),
+    storeFillPattern(static_cast<unsigned char>(
+        simConfig.StoreFillPattern.value_or(DEFAULT_STORE_FILL_PATTERN))),
+    saveCheckpoint(simConfig.SaveCheckpoint.value_or("")),
+    saveCheckpointCycle(simConfig.SaveCheckpointCycle.value_or(DEFAULT_SAVE_CHECKPOINT_CYCLE)),
+    saveCheckpointTimeout(
+        simConfig.SaveCheckpointTimeout.value_or(DEFAULT_SAVE_CHECKPOINT_TIMEOUT)),
+    restoreCheckpoint(simConfig.RestoreCheckpoint.value_or("")),
+    fastForwardCycles(simConfig.FastForwardCycles.value_or(DEFAULT_FAST_FORWARD_CYCLES)),
+    samplingInterval(simConfig.SamplingInterval.value_or(DEFAULT_SAMPLING_INTERVAL)),
+    samplingWarmup(simConfig.SamplingWarmup.value_or(DEFAULT_SAMPLING_WARMUP)),
+    samplingWindow(simConfig.SamplingWindow.value_or(DEFAULT_SAMPLING_WINDOW))
 {
     if (storeMode == Config::StoreModeType::Invalid)
         SC_REPORT_FATAL("SimConfig", "Invalid StoreMode");
 
+    if (simConfig.StoreFillPattern.value_or(DEFAULT_STORE_FILL_PATTERN) > 0xFF)
+        SC_REPORT_FATAL("SimConfig", "StoreFillPattern must be a single byte");
+
     if (windowSize == 0)
         SC_REPORT_FATAL("SimConfig", "Minimum window size is 1");
 
+    if (samplingInterval > 0)
+    {
+        if (samplingWindow == 0)
+            SC_REPORT_FATAL("SimConfig", "Minimum sampling window is 1");
+
+        if (samplingWarmup + samplingWindow > samplingInterval)
+            SC_REPORT_FATAL("SimConfig",
+                            "SamplingWarmup and SamplingWindow must fit into SamplingInterval");
+    }
+
 #ifndef DRAMPOWER
     if (powerAnalysis)
         SC_REPORT_FATAL("SimConfig",
@@ -58,6 +58,15 @@ struct SimConfig
     bool useMalloc;
     unsigned long long int addressOffset;
     Config::StoreModeType storeMode;
+    unsigned char storeFillPattern;
+    std::string saveCheckpoint;
+    uint64_t saveCheckpointCycle;
+    uint64_t saveCheckpointTimeout;
+    std::string restoreCheckpoint;
+    uint64_t fastForwardCycles;
+    uint64_t samplingInterval;
+    uint64_t samplingWarmup;
+    uint64_t samplingWindow;
 
     static constexpr std::string_view DEFAULT_SIMULATION_NAME = "default";
     static constexpr bool DEFAULT_DATABASE_RECORDING = false;
@@ -70,6 +79,13 @@ struct SimConfig
     static constexpr bool DEFAULT_USE_MALLOC = false;
     static constexpr unsigned long long int DEFAULT_ADDRESS_OFFSET = 0;
     static constexpr Config::StoreModeType DEFAULT_STORE_MODE = Config::StoreModeType::NoStorage;
+    static constexpr unsigned int DEFAULT_STORE_FILL_PATTERN = 0x00;
+    static constexpr uint64_t DEFAULT_SAVE_CHECKPOINT_CYCLE = 0;
+    static constexpr uint64_t DEFAULT_SAVE_CHECKPOINT_TIMEOUT = 1000000;
+    static constexpr uint64_t DEFAULT_FAST_FORWARD_CYCLES = 0;
+    static constexpr uint64_t DEFAULT_SAMPLING_INTERVAL = 0;
+    static constexpr uint64_t DEFAULT_SAMPLING_WARMUP = 1000;
+    static constexpr uint64_t DEFAULT_SAMPLING_WINDOW = 10000;
 };
 
 } // namespace DRAMSys
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SparseMemory.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <systemc>
+#include <tlm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+namespace DRAMSys
+{
+
+#ifdef __SSE2__
+static constexpr std::size_t MASK_BLOCK_SIZE = 16;
+#endif
+
+// Copies the bytes whose byte enable equals TLM_BYTE_ENABLED from source to destination, or
+// writes the fill pattern instead if there is no source. The byte enable pattern repeats every
+// byteEnableLength bytes and position is the index of the first byte within the whole data.
+static void maskedCopy(unsigned char* destination,
+                       const unsigned char* source,
+                       unsigned char fillPattern,
+                       std::size_t length,
+                       const unsigned char* byteEnable,
+                       std::size_t byteEnableLength,
+                       std::size_t position)
+{
+    std::size_t offset = position % byteEnableLength;
+    std::size_t i = 0;
+
+#ifdef __SSE2__
+    // Short patterns are expanded once, so that every block of byte enables can be read
+    // contiguously starting at any offset within the period of the pattern
+    unsigned char expanded[2 * MASK_BLOCK_SIZE];
+    const unsigned char* pattern = byteEnable;
+    std::size_t patternLength = byteEnableLength;
+    if (byteEnableLength < MASK_BLOCK_SIZE)
+    {
+        patternLength = byteEnableLength + MASK_BLOCK_SIZE;
+        for (std::size_t j = 0; j < patternLength; j++)
+            expanded[j] = byteEnable[j % byteEnableLength];
+        pattern = expanded;
+    }
+
+    const __m128i enabled = _mm_set1_epi8(static_cast<char>(tlm::TLM_BYTE_ENABLED));
+    const __m128i fill = _mm_set1_epi8(static_cast<char>(fillPattern));
+    unsigned char wrapped[MASK_BLOCK_SIZE];
+
+    for (; i + MASK_BLOCK_SIZE <= length; i += MASK_BLOCK_SIZE)
+    {
+        const unsigned char* block = pattern + offset;
+        if (offset + MASK_BLOCK_SIZE > patternLength)
+        {
+            // Only long patterns wrap around within a block, at most once per period
+            for (std::size_t j = 0; j < MASK_BLOCK_SIZE; j++)
+                wrapped[j] = byteEnable[(offset + j) % byteEnableLength];
+            block = wrapped;
+        }
+
+        __m128i mask = _mm_cmpeq_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), enabled);
+        __m128i data = source != nullptr
+                           ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i))
+                           : fill;
+        __m128i old = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i));
+        __m128i result = _mm_or_si128(_mm_and_si128(mask, data), _mm_andnot_si128(mask, old));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), result);
+
+        offset = (offset + MASK_BLOCK_SIZE) % byteEnableLength;
+    }
+#endif
+
+    for (; i < length; i++)
+    {
+        if (byteEnable[offset] == tlm::TLM_BYTE_ENABLED)
+            destination[i] = source != nullptr ? source[i] : fillPattern;
+
+        if (++offset == byteEnableLength)
+            offset = 0;
+    }
+}
+
+SparseMemory::SparseMemory(uint64_t size, unsigned char fillPattern, bool useMalloc) :
+    memorySize(size),
+    fillPattern(fillPattern),
+    useMalloc(useMalloc)
+{
+    uint64_t numberOfPages = (memorySize + PAGE_SIZE - 1) / PAGE_SIZE;
+    directory.resize((numberOfPages + PAGES_PER_TABLE - 1) / PAGES_PER_TABLE);
+}
+
+SparseMemory::~SparseMemory()
+{
+    clear();
+}
+
+void SparseMemory::read(uint64_t address,
+                        unsigned char* data,
+                        std::size_t length,
+                        const unsigned char* byteEnable,
+                        std::size_t byteEnableLength) const
+{
+    if (address + length > memorySize)
+        SC_REPORT_FATAL("SparseMemory", "Read access exceeds the channel size");
+
+    std::size_t done = 0;
+    while (done < length)
+    {
+        uint64_t pageIndex = (address + done) / PAGE_SIZE;
+        uint64_t pageOffset = (address + done) % PAGE_SIZE;
+        std::size_t chunk = std::min<uint64_t>(length - done, PAGE_SIZE - pageOffset);
+        const unsigned char* page = findPage(pageIndex);
+
+        if (byteEnable == nullptr)
+        {
+            if (page != nullptr)
+                std::memcpy(data + done, page + pageOffset, chunk);
+            else
+                std::memset(data + done, fillPattern, chunk);
+        }
+        else
+        {
+            maskedCopy(data + done,
+                       page != nullptr ? page + pageOffset : nullptr,
+                       fillPattern,
+                       chunk,
+                       byteEnable,
+                       byteEnableLength,
+                       done);
+        }
+
+        done += chunk;
+    }
+}
+
+void SparseMemory::write(uint64_t address,
+                         const unsigned char* data,
+                         std::size_t length,
+                         const unsigned char* byteEnable,
+                         std::size_t byteEnableLength)
+{
+    if (address + length > memorySize)
+        SC_REPORT_FATAL("SparseMemory", "Write access exceeds the channel size");
+
+    std::size_t done = 0;
+    while (done < length)
+    {
+        uint64_t pageIndex = (address + done) / PAGE_SIZE;
+        uint64_t pageOffset = (address + done) % PAGE_SIZE;
+        std::size_t chunk = std::min<uint64_t>(length - done, PAGE_SIZE - pageOffset);
+        unsigned char* page = touchPage(pageIndex);
+
+        if (byteEnable == nullptr)
+        {
+            std::memcpy(page + pageOffset, data + done, chunk);
+        }
+        else
+        {
+            maskedCopy(page + pageOffset,
+                       data + done,
+                       fillPattern,
+                       chunk,
+                       byteEnable,
+                       byteEnableLength,
+                       done);
+        }
+
+        done += chunk;
+    }
+}
+
+void SparseMemory::serialize(std::ostream& stream) const
+{
+    auto count = static_cast<uint64_t>(pageCount);
+    stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    for (std::size_t tableIndex = 0; tableIndex < directory.size(); tableIndex++)
+    {
+        if (directory[tableIndex] == nullptr)
+            continue;
+
+        for (std::size_t entry = 0; entry < PAGES_PER_TABLE; entry++)
+        {
+            const unsigned char* page = (*directory[tableIndex])[entry];
+            if (page == nullptr)
+                continue;
+
+            uint64_t pageIndex = tableIndex * PAGES_PER_TABLE + entry;
+            stream.write(reinterpret_cast<const char*>(&pageIndex), sizeof(pageIndex));
+            stream.write(reinterpret_cast<const char*>(page),
+                         static_cast<std::streamsize>(pageLength(pageIndex)));
+        }
+    }
+}
+
+void SparseMemory::deserialize(std::istream& stream)
+{
+    // Pages that are not part of the stream return to the fill pattern
+    clear();
+
+    uint64_t count = 0;
+    stream.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+    for (uint64_t i = 0; i < count && stream; i++)
+    {
+        uint64_t pageIndex = 0;
+        stream.read(reinterpret_cast<char*>(&pageIndex), sizeof(pageIndex));
+
+        if (pageIndex >= directory.size() * PAGES_PER_TABLE ||
+            pageIndex * PAGE_SIZE >= memorySize)
+            SC_REPORT_FATAL("SparseMemory",
+                            ("Page " + std::to_string(pageIndex) + " exceeds the channel size")
+                                .c_str());
+
+        stream.read(reinterpret_cast<char*>(touchPage(pageIndex)),
+                    static_cast<std::streamsize>(pageLength(pageIndex)));
+    }
+
+    if (!stream)
+        SC_REPORT_FATAL("SparseMemory", "Unexpected end of memory image");
+}
+
+unsigned char* SparseMemory::touchPage(uint64_t pageIndex)
+{
+    std::unique_ptr<PageTable>& table = directory[pageIndex / PAGES_PER_TABLE];
+    if (table == nullptr)
+    {
+        table = std::make_unique<PageTable>();
+        table->fill(nullptr);
+    }
+
+    unsigned char*& page = (*table)[pageIndex % PAGES_PER_TABLE];
+    if (page == nullptr)
+    {
+        page = allocatePage();
+        pageCount++;
+    }
+
+    return page;
+}
+
+uint64_t SparseMemory::pageLength(uint64_t pageIndex) const
+{
+    return std::min(PAGE_SIZE, memorySize - pageIndex * PAGE_SIZE);
+}
+
+unsigned char* SparseMemory::allocatePage() const
+{
+#ifndef _WIN32
+    if (!useMalloc)
+    {
+        // Map twice the page size so that the page can be placed on a huge page boundary
+        void* mapping = mmap(nullptr,
+                             2 * PAGE_SIZE,
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANON | MAP_NORESERVE,
+                             -1,
+                             0);
+        if (mapping == MAP_FAILED)
+            SC_REPORT_FATAL("SparseMemory", "Memory mapping failed");
+
+        auto base = reinterpret_cast<uintptr_t>(mapping);
+        uintptr_t aligned = (base + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+        if (aligned != base)
+            munmap(mapping, aligned - base);
+        munmap(reinterpret_cast<void*>(aligned + PAGE_SIZE), base + PAGE_SIZE - aligned);
+
+        auto* page = reinterpret_cast<unsigned char*>(aligned);
+#ifdef MADV_HUGEPAGE
+        madvise(page, PAGE_SIZE, MADV_HUGEPAGE);
+#endif
+        // Anonymous mappings are already zeroed
+        if (fillPattern != 0)
+            std::memset(page, fillPattern, PAGE_SIZE);
+
+        return page;
+    }
+#endif
+
+    auto* page = static_cast<unsigned char*>(std::malloc(PAGE_SIZE));
+    if (page == nullptr)
+        SC_REPORT_FATAL("SparseMemory", "Memory allocation failed");
+
+    std::memset(page, fillPattern, PAGE_SIZE);
+    return page;
+}
+
+void SparseMemory::freePage(unsigned char* page) const
+{
+#ifndef _WIN32
+    if (!useMalloc)
+    {
+        munmap(page, PAGE_SIZE);
+        return;
+    }
+#endif
+
+    std::free(page);
+}
+
+void SparseMemory::clear()
+{
+    for (auto& table : directory)
+    {
+        if (table == nullptr)
+            continue;
+
+        for (unsigned char* page : *table)
+        {
+            if (page != nullptr)
+                freePage(page);
+        }
+
+        table.reset();
+    }
+
+    pageCount = 0;
+}
+
+} // namespace DRAMSys
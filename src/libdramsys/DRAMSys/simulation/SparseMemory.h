@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SPARSEMEMORY_H
+#define SPARSEMEMORY_H
+
+#include "DRAMSys/common/Deserialize.h"
+#include "DRAMSys/common/Serialize.h"
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace DRAMSys
+{
+
+// Backing storage of one DRAM channel. The address space is split into 2 MiB pages that are
+// looked up through a two-level page table and only allocated on their first write. Reads from
+// pages that were never written return the fill pattern without allocating anything, so huge
+// channels with a sparse footprint only cost what is actually touched.
+class SparseMemory : public Serialize, public Deserialize
+{
+public:
+    static constexpr uint64_t PAGE_SIZE = 2 * 1024 * 1024;
+    static constexpr std::size_t PAGES_PER_TABLE = 512;
+
+    SparseMemory(uint64_t size, unsigned char fillPattern, bool useMalloc);
+    ~SparseMemory() override;
+
+    SparseMemory(const SparseMemory&) = delete;
+    SparseMemory(SparseMemory&&) = delete;
+    SparseMemory& operator=(const SparseMemory&) = delete;
+    SparseMemory& operator=(SparseMemory&&) = delete;
+
+    // The byte enable pattern is repeated over the data if it is shorter than the data
+    void read(uint64_t address,
+              unsigned char* data,
+              std::size_t length,
+              const unsigned char* byteEnable = nullptr,
+              std::size_t byteEnableLength = 0) const;
+    void write(uint64_t address,
+               const unsigned char* data,
+               std::size_t length,
+               const unsigned char* byteEnable = nullptr,
+               std::size_t byteEnableLength = 0);
+
+    uint64_t size() const { return memorySize; }
+    std::size_t allocatedPages() const { return pageCount; }
+
+    // Only pages that have been written are part of the stream
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+
+private:
+    using PageTable = std::array<unsigned char*, PAGES_PER_TABLE>;
+
+    const uint64_t memorySize;
+    const unsigned char fillPattern;
+    const bool useMalloc;
+
+    std::vector<std::unique_ptr<PageTable>> directory;
+    std::size_t pageCount = 0;
+
+    unsigned char* findPage(uint64_t pageIndex) const
+    {
+        const PageTable* table = directory[pageIndex / PAGES_PER_TABLE].get();
+        return table != nullptr ? (*table)[pageIndex % PAGES_PER_TABLE] : nullptr;
+    }
+
+    unsigned char* touchPage(uint64_t pageIndex);
+    uint64_t pageLength(uint64_t pageIndex) const;
+    unsigned char* allocatePage() const;
+    void freePage(unsigned char* page) const;
+    void clear();
+};
+
+} // namespace DRAMSys
+
+#endif // SPARSEMEMORY_H
@@ -37,7 +37,10 @@
 #include "Cache.h"
 #include "MemoryManager.h"
 
+#include <algorithm>
 #include <cstring>
+#include <iomanip>
+#include <iostream>
 
 using namespace tlm;
 using namespace sc_core;
@@ -55,6 +58,12 @@ Cache::Cache(const sc_module_name& name,
              bool storageEnabled,
              sc_core::sc_time cycleTime,
              std::size_t hitCycles,
+             DRAMSys::Config::ReplacementPolicyType replacementPolicyType,
+             DRAMSys::Config::PrefetcherType prefetcherType,
+             unsigned int prefetchDegree,
+             std::size_t prefetchTableSize,
+             uint64_t memoryOffset,
+             uint64_t memorySize,
              MemoryManager& memoryManager) :
     sc_module(name),
     payloadEventQueue(this, &Cache::peqCallback),
@@ -71,25 +80,51 @@ Cache::Cache(const sc_module_name& name,
     mshrDepth(mshrDepth),
     writeBufferDepth(writeBufferDepth),
     maxTargetListSize(maxTargetListSize),
+    lineTags(numberOfSets * associativity, 0),
+    lineFlags(numberOfSets * associativity, 0),
+    evictionCandidates(associativity),
+    memoryStart(memoryOffset),
+    memoryEnd(memoryOffset + memorySize),
+    mshrQueue(mshrDepth, Mshr(maxTargetListSize)),
+    writeBuffer(writeBufferDepth),
     memoryManager(memoryManager)
 {
     iSocket.register_nb_transport_bw(this, &Cache::nb_transport_bw);
     tSocket.register_nb_transport_fw(this, &Cache::nb_transport_fw);
 
-    lineTable =
-        std::vector<std::vector<CacheLine>>(numberOfSets, std::vector<CacheLine>(associativity));
+    if (associativity == 0)
+        SC_REPORT_FATAL("Cache", "Associativity must be greater than zero!");
+
+    if (numberOfSets == 0 || (numberOfSets & (numberOfSets - 1)) != 0 ||
+        (lineSize & (lineSize - 1)) != 0)
+        SC_REPORT_FATAL("Cache", "Line size and number of sets must be powers of two!");
+
+    if (replacementPolicyType == DRAMSys::Config::ReplacementPolicyType::Lru)
+        replacementPolicy = std::make_unique<LruPolicy>(numberOfSets, associativity);
+    else if (replacementPolicyType == DRAMSys::Config::ReplacementPolicyType::TreePlru)
+        replacementPolicy = std::make_unique<TreePlruPolicy>(numberOfSets, associativity);
+    else if (replacementPolicyType == DRAMSys::Config::ReplacementPolicyType::Srrip)
+        replacementPolicy = std::make_unique<SrripPolicy>(numberOfSets, associativity);
+    else if (replacementPolicyType == DRAMSys::Config::ReplacementPolicyType::Random)
+        replacementPolicy = std::make_unique<RandomPolicy>(numberOfSets, associativity);
+    else
+        SC_REPORT_FATAL("Cache", "Invalid replacement policy");
 
-    if (storageEnabled)
-    {
-        dataMemory.reserve(size);
+    if (prefetcherType == DRAMSys::Config::PrefetcherType::NextLine)
+        prefetcher = std::make_unique<NextLinePrefetcher>(lineSize, prefetchDegree);
+    else if (prefetcherType == DRAMSys::Config::PrefetcherType::Stride)
+        prefetcher =
+            std::make_unique<StridePrefetcher>(lineSize, prefetchDegree, prefetchTableSize);
+    else if (prefetcherType == DRAMSys::Config::PrefetcherType::Stream)
+        prefetcher =
+            std::make_unique<StreamPrefetcher>(lineSize, prefetchDegree, prefetchTableSize);
+    else if (prefetcherType != DRAMSys::Config::PrefetcherType::None)
+        SC_REPORT_FATAL("Cache", "Invalid prefetcher");
 
-        for (std::size_t set = 0; set < lineTable.size(); set++)
-        {
-            for (std::size_t way = 0; way < lineTable[set].size(); way++)
-                lineTable[set][way].dataPtr =
-                    dataMemory.data() + set * associativity * lineSize + way * lineSize;
-        }
-    }
+    prefetchAddresses.reserve(prefetchDegree);
+
+    if (storageEnabled)
+        dataMemory.resize(size);
 }
 
 tlm_sync_enum Cache::nb_transport_fw(tlm_generic_payload& trans,
@@ -176,17 +211,15 @@ void Cache::peqCallback(tlm_generic_payload& trans, const tlm_phase& phase)
         tag_t tag = 0;
         std::tie(index, tag, std::ignore) = decodeAddress(trans.get_address());
 
-        auto mshrIt = std::find_if(mshrQueue.begin(),
-                                   mshrQueue.end(),
-                                   [index, tag](const Mshr& mshr)
-                                   { return mshr.index == index && mshr.tag == tag; });
+        std::size_t mshrPosition = findMshr(index, tag);
 
-        assert(mshrIt != mshrQueue.end());
-        mshrIt->hitDelayAccounted = true;
+        assert(mshrPosition != mshrQueue.size());
+        Mshr& mshr = mshrQueue[mshrPosition];
+        mshr.hitDelayAccounted = true;
 
-        if (mshrIt->requestList.empty())
+        if (mshr.requestList.empty())
         {
-            mshrQueue.erase(mshrIt);
+            mshrQueue.erase(mshrPosition);
 
             if (endRequestPending != nullptr && hasBufferSpace())
             {
@@ -210,53 +243,57 @@ void Cache::fetchLineAndSendEndRequest(tlm_generic_payload& trans)
         tag_t tag = 0;
         std::tie(index, tag, std::ignore) = decodeAddress(trans.get_address());
 
-        auto mshrEntry = std::find_if(mshrQueue.begin(),
-                                      mshrQueue.end(),
-                                      [index, tag](const Mshr& entry)
-                                      { return (index == entry.index) && (tag == entry.tag); });
+        std::size_t mshrPosition = findMshr(index, tag);
+        bool prefetchTrigger = true;
 
         if (isHit(index, tag))
         {
             numberOfHits++;
+            prefetchTrigger = consumePrefetch(index, findWay(index, tag, Valid));
 
             // Handle hit
             // Account for the 1 cycle accept delay.
             payloadEventQueue.notify(trans, HIT_HANDLING, hitLatency + cycleTime);
         }
-        else if (mshrEntry != mshrQueue.end()) // Miss with outstanding previous Miss, noted in MSHR
+        // Miss with outstanding previous Miss, noted in MSHR
+        else if (mshrPosition != mshrQueue.size())
         {
-            numberOfSecondaryMisses++;
             assert(isAllocated(index, tag));
 
             // A fetch for this cache line is already in progress
             // Add request to the existing Mshr entry
 
-            if (mshrEntry->requestList.size() == maxTargetListSize)
+            Mshr& mshr = mshrQueue[mshrPosition];
+            if (mshr.requestList.full())
             {
                 // Insertion into requestList in mshrEntry not possible.
                 endRequestPending = &trans;
                 return;
             }
 
-            mshrEntry->requestList.emplace_back(&trans);
+            mshr.requestList.push_back(&trans);
+            numberOfSecondaryMisses++;
+
+            // A late prefetch still hides a part of the miss latency
+            consumePrefetch(index, findWay(index, tag, Allocated));
         }
         else // Miss without MSHR entry:
         {
-            numberOfPrimaryMisses++;
             assert(!isAllocated(index, tag));
 
             // Cache miss and no fetch in progress.
             // So evict line and allocate empty line.
-            auto* evictedLine = evictLine(index);
-            if (evictedLine == nullptr)
+            std::optional<way_t> evictedWay = evictLine(index);
+            if (!evictedWay.has_value())
             {
                 // Line eviction not possible.
                 endRequestPending = &trans;
                 return;
             }
 
-            allocateLine(evictedLine, tag);
-            mshrQueue.emplace_back(index, tag, &trans);
+            allocateLine(index, *evictedWay, tag);
+            mshrQueue.allocateBack().reset(index, tag, &trans);
+            numberOfPrimaryMisses++;
 
             processMshrQueue();
             processWriteBuffer();
@@ -265,6 +302,9 @@ void Cache::fetchLineAndSendEndRequest(tlm_generic_payload& trans)
         tlm_phase bwPhase = END_REQ;
         sc_time bwDelay = SC_ZERO_TIME;
         tSocket->nb_transport_bw(trans, bwPhase, bwDelay);
+
+        if (prefetcher)
+            issuePrefetches(getAlignedAddress(trans.get_address()), prefetchTrigger);
     }
     else
     {
@@ -272,6 +312,59 @@ void Cache::fetchLineAndSendEndRequest(tlm_generic_payload& trans)
     }
 }
 
+/// Allocates lines and MSHR entries for the lines proposed by the prefetcher. One MSHR entry
+/// and one write buffer entry are always left for demand requests.
+void Cache::issuePrefetches(uint64_t lineAddress, bool trigger)
+{
+    prefetchAddresses.clear();
+    prefetcher->access(lineAddress, trigger, prefetchAddresses);
+
+    bool issued = false;
+    for (uint64_t prefetchAddress : prefetchAddresses)
+    {
+        if (mshrQueue.size() + 1 >= mshrDepth || writeBuffer.size() + 1 >= writeBufferDepth)
+            break;
+
+        if (prefetchAddress < memoryStart || prefetchAddress + lineSize > memoryEnd)
+            continue;
+
+        index_t index = 0;
+        tag_t tag = 0;
+        std::tie(index, tag, std::ignore) = decodeAddress(prefetchAddress);
+
+        if (isAllocated(index, tag))
+            continue;
+
+        std::optional<way_t> evictedWay = evictLine(index);
+        if (!evictedWay.has_value())
+            continue;
+
+        allocateLine(index, *evictedWay, tag);
+        lineFlags[getLine(index, *evictedWay)] |= Prefetched;
+        mshrQueue.allocateBack().reset(index, tag, nullptr);
+
+        numberOfPrefetches++;
+        issued = true;
+    }
+
+    if (issued)
+    {
+        processMshrQueue();
+        processWriteBuffer();
+    }
+}
+
+bool Cache::consumePrefetch(index_t index, way_t way)
+{
+    std::uint8_t& flags = lineFlags[getLine(index, way)];
+    if ((flags & Prefetched) == 0)
+        return false;
+
+    flags &= ~Prefetched;
+    numberOfUsefulPrefetches++;
+    return true;
+}
+
 /// Handler for end request from DRAM side.
 void Cache::clearInitiatorBackpressureAndProcessBuffers()
 {
@@ -322,13 +415,34 @@ unsigned int Cache::transport_dbg(tlm_generic_payload& trans)
     return iSocket->transport_dbg(trans);
 }
 
+unsigned char* Cache::getLineData(index_t index, way_t way)
+{
+    return dataMemory.data() + getLine(index, way) * lineSize;
+}
+
+Cache::way_t Cache::findWay(index_t index, tag_t tag, std::uint8_t flags) const
+{
+    const tag_t* setTags = lineTags.data() + getLine(index, 0);
+    const std::uint8_t* setFlags = lineFlags.data() + getLine(index, 0);
+
+    for (way_t way = 0; way < associativity; way++)
+    {
+        if (setTags[way] == tag && (setFlags[way] & flags) == flags)
+            return way;
+    }
+
+    return associativity;
+}
+
+std::size_t Cache::findMshr(index_t index, tag_t tag) const
+{
+    return mshrQueue.findIf([index, tag](const Mshr& entry)
+                            { return (index == entry.index) && (tag == entry.tag); });
+}
+
 bool Cache::isHit(index_t index, tag_t tag) const
 {
-    return std::find_if(lineTable[index].begin(),
-                        lineTable[index].end(),
-                        [tag](const CacheLine& cacheLine) {
-                            return (cacheLine.tag == tag) && cacheLine.valid;
-                        }) != lineTable[index].end();
+    return findWay(index, tag, Valid) != associativity;
 }
 
 bool Cache::isHit(uint64_t address) const
@@ -361,17 +475,14 @@ void Cache::writeLine(index_t index,
 {
     // SC_REPORT_ERROR("cache", "Write to Cache not allowed!");
 
-    CacheLine& currentLine =
-        *std::find_if(lineTable[index].begin(),
-                      lineTable[index].end(),
-                      [tag](const CacheLine& cacheLine) { return cacheLine.tag == tag; });
+    way_t way = findWay(index, tag, Valid);
+    assert(way != associativity);
 
-    assert(currentLine.valid);
-    currentLine.lastAccessTime = sc_time_stamp();
-    currentLine.dirty = true;
+    replacementPolicy->touch(index, way);
+    lineFlags[getLine(index, way)] |= Dirty;
 
     if (storageEnabled)
-        std::copy(dataPtr, dataPtr + dataLength, currentLine.dataPtr + lineOffset);
+        std::copy(dataPtr, dataPtr + dataLength, getLineData(index, way) + lineOffset);
 }
 
 /// Read data from an available cache line, update flags
@@ -381,75 +492,88 @@ void Cache::readLine(index_t index,
                      unsigned int dataLength,
                      unsigned char* dataPtr)
 {
-    CacheLine& currentLine =
-        *std::find_if(lineTable[index].begin(),
-                      lineTable[index].end(),
-                      [tag](const CacheLine& cacheLine) { return cacheLine.tag == tag; });
+    way_t way = findWay(index, tag, Valid);
+    assert(way != associativity);
 
-    assert(currentLine.valid);
-    currentLine.lastAccessTime = sc_time_stamp();
+    replacementPolicy->touch(index, way);
 
     if (storageEnabled)
-        std::copy(currentLine.dataPtr + lineOffset,
-                  currentLine.dataPtr + lineOffset + dataLength,
-                  dataPtr);
+    {
+        const unsigned char* lineData = getLineData(index, way);
+        std::copy(lineData + lineOffset, lineData + lineOffset + dataLength, dataPtr);
+    }
 }
 
-/// Tries to evict oldest line (insert into write memory)
-/// Returns the line or a nullptr if not possible
-Cache::CacheLine* Cache::evictLine(Cache::index_t index)
+/// Tries to evict a free or else the line chosen by the replacement policy (insert into write
+/// memory)
+/// Returns the way of the line or no value if not possible
+std::optional<Cache::way_t> Cache::evictLine(Cache::index_t index)
 {
-    CacheLine& oldestLine = *std::min_element(lineTable[index].begin(),
-                                              lineTable[index].end(),
-                                              [](const CacheLine& lhs, const CacheLine& rhs)
-                                              { return lhs.lastAccessTime < rhs.lastAccessTime; });
+    const std::uint8_t* setFlags = lineFlags.data() + getLine(index, 0);
 
-    if (oldestLine.allocated && !oldestLine.valid)
+    // Lines that are allocated but not yet valid have a fetch in progress and cannot be evicted
+    way_t victim = associativity;
+    for (way_t way = 0; way < associativity; way++)
     {
-        // oldestline is allocated but not yet valid -> fetch in progress
-        return nullptr;
-    }
-    if (std::find_if(mshrQueue.begin(),
-                     mshrQueue.end(),
-                     [index, oldestLine](const Mshr& entry) {
-                         return (index == entry.index) && (oldestLine.tag == entry.tag);
-                     }) != mshrQueue.end())
-    {
-        // TODO: solve this in a more clever way
-        // There are still entries in mshrQueue to the oldest line -> do not evict it
-        return nullptr;
+        if ((setFlags[way] & Allocated) == 0)
+        {
+            victim = way;
+            break;
+        }
+
+        evictionCandidates[way] = (setFlags[way] & Valid) != 0;
     }
-    if (std::find_if(hitQueue.begin(),
-                     hitQueue.end(),
-                     [index, oldestLine](const BufferEntry& entry) {
-                         return (index == entry.index) && (oldestLine.tag == entry.tag);
-                     }) != hitQueue.end())
+
+    if (victim == associativity)
+        victim = replacementPolicy->getVictim(index, evictionCandidates);
+
+    if (victim == associativity)
+        return std::nullopt;
+
+    std::size_t line = getLine(index, victim);
+    tag_t victimTag = lineTags[line];
+
+    if ((lineFlags[line] & Allocated) != 0)
     {
-        // TODO: solve this in a more clever way
-        // There are still hits in hitQueue to the oldest line -> do not evict it
-        return nullptr;
+        if (findMshr(index, victimTag) != mshrQueue.size())
+        {
+            // TODO: solve this in a more clever way
+            // There are still entries in mshrQueue to the oldest line -> do not evict it
+            return std::nullopt;
+        }
+        if (std::find_if(hitQueue.begin(),
+                         hitQueue.end(),
+                         [index, victimTag](const BufferEntry& entry) {
+                             return (index == entry.index) && (victimTag == entry.tag);
+                         }) != hitQueue.end())
+        {
+            // TODO: solve this in a more clever way
+            // There are still hits in hitQueue to the oldest line -> do not evict it
+            return std::nullopt;
+        }
     }
 
-    if (oldestLine.valid && oldestLine.dirty)
+    if ((lineFlags[line] & (Valid | Dirty)) == (Valid | Dirty))
     {
-        auto& wbTrans = memoryManager.allocate(lineSize);
+        auto& wbTrans = memoryManager.allocate(lineSize, false);
         wbTrans.acquire();
-        wbTrans.set_address(encodeAddress(index, oldestLine.tag));
+        wbTrans.set_address(encodeAddress(index, victimTag));
         wbTrans.set_write();
         wbTrans.set_data_length(lineSize);
         wbTrans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
 
         if (storageEnabled)
-            std::copy(oldestLine.dataPtr, oldestLine.dataPtr + lineSize, wbTrans.get_data_ptr());
+        {
+            const unsigned char* lineData = getLineData(index, victim);
+            std::copy(lineData, lineData + lineSize, wbTrans.get_data_ptr());
+        }
 
-        writeBuffer.emplace_back(index, oldestLine.tag, &wbTrans);
+        writeBuffer.push_back({index, victimTag, &wbTrans});
     }
 
-    oldestLine.allocated = false;
-    oldestLine.valid = false;
-    oldestLine.dirty = false;
+    lineFlags[line] = 0;
 
-    return &oldestLine;
+    return victim;
 }
 
 /// Align address to cache line size
@@ -464,43 +588,47 @@ void Cache::processMshrQueue()
     if ((requestInProgress == nullptr) && !mshrQueue.empty())
     {
         // Get the first entry that wasn't already issued to the target
-        auto mshrIt = std::find_if(
-            mshrQueue.begin(), mshrQueue.end(), [](const Mshr& entry) { return !entry.issued; });
+        std::size_t mshrPosition =
+            mshrQueue.findIf([](const Mshr& entry) { return !entry.issued; });
 
-        if (mshrIt == mshrQueue.end())
+        if (mshrPosition == mshrQueue.size())
             return;
 
-        // Note: This is the same address for all entries in the requests list
-        uint64_t alignedAddress = getAlignedAddress(mshrIt->requestList.front()->get_address());
+        Mshr& mshr = mshrQueue[mshrPosition];
 
-        index_t index = 0;
-        tag_t tag = 0;
-        std::tie(index, tag, std::ignore) = decodeAddress(alignedAddress);
+        index_t index = mshr.index;
+        tag_t tag = mshr.tag;
+        uint64_t alignedAddress = encodeAddress(index, tag);
 
         // Search through the writeBuffer in reverse order to get the most recent entry.
-        auto writeBufferEntry =
-            std::find_if(writeBuffer.rbegin(),
-                         writeBuffer.rbegin(),
-                         [index, tag](const BufferEntry& entry)
-                         { return (index == entry.index) && (tag == entry.tag); });
+        tlm_generic_payload* writeBufferTrans = nullptr;
+        for (std::size_t i = writeBuffer.size(); i > 0; i--)
+        {
+            const BufferEntry& entry = writeBuffer[i - 1];
+            if ((index == entry.index) && (tag == entry.tag))
+            {
+                writeBufferTrans = entry.trans;
+                break;
+            }
+        }
 
-        if (writeBufferEntry != writeBuffer.rbegin())
+        if (writeBufferTrans != nullptr)
         {
             // There is an entry for the required line in the write buffer.
             // Snoop into it and get the data from there instead of the dram.
-            mshrIt->issued = true;
+            mshr.issued = true;
             clearInitiatorBackpressureAndProcessBuffers();
 
-            fillLine(*writeBufferEntry->trans);
+            fillLine(*writeBufferTrans);
             processMshrResponse();
 
             return;
         }
 
         // Prevents that the cache line will get fetched multiple times from the target
-        mshrIt->issued = true;
+        mshr.issued = true;
 
-        auto& fetchTrans = memoryManager.allocate(lineSize);
+        auto& fetchTrans = memoryManager.allocate(lineSize, false);
         fetchTrans.acquire();
         fetchTrans.set_read();
         fetchTrans.set_data_length(lineSize);
@@ -581,16 +709,27 @@ void Cache::fillLine(tlm_generic_payload& trans)
     tag_t tag = 0;
     std::tie(index, tag, std::ignore) = decodeAddress(trans.get_address());
 
-    CacheLine& allocatedLine = *std::find_if(
-        lineTable[index].begin(),
-        lineTable[index].end(),
-        [tag](const CacheLine& cacheLine) { return cacheLine.allocated && cacheLine.tag == tag; });
+    way_t way = findWay(index, tag, Allocated);
+    assert(way != associativity);
 
-    allocatedLine.valid = true;
-    allocatedLine.dirty = false;
+    std::uint8_t& flags = lineFlags[getLine(index, way)];
+    flags = (flags | Valid) & ~Dirty;
 
     if (storageEnabled)
-        std::copy(trans.get_data_ptr(), trans.get_data_ptr() + lineSize, allocatedLine.dataPtr);
+        std::copy(trans.get_data_ptr(), trans.get_data_ptr() + lineSize, getLineData(index, way));
+
+    // A prefetch without merged demand requests is completed with the fill
+    std::size_t mshrPosition = findMshr(index, tag);
+    if (mshrPosition != mshrQueue.size() && mshrQueue[mshrPosition].requestList.empty())
+    {
+        mshrQueue.erase(mshrPosition);
+
+        if (endRequestPending != nullptr && hasBufferSpace())
+        {
+            payloadEventQueue.notify(*endRequestPending, BEGIN_REQ, SC_ZERO_TIME);
+            endRequestPending = nullptr;
+        }
+    }
 }
 
 /// Make cache access for pending hits
@@ -630,23 +769,20 @@ void Cache::accessCacheAndSendResponse(tlm_generic_payload& trans)
     tSocketBackpressure = true;
 }
 
-/// Allocates an empty line for later filling (lastAccessTime = sc_max_time())
-void Cache::allocateLine(CacheLine* line, tag_t tag)
+/// Allocates an empty line for later filling
+void Cache::allocateLine(index_t index, way_t way, tag_t tag)
 {
-    line->allocated = true;
-    line->tag = tag;
-    line->lastAccessTime = sc_max_time();
+    std::size_t line = getLine(index, way);
+    lineTags[line] = tag;
+    lineFlags[line] = Allocated;
+    replacementPolicy->insert(index, way);
 }
 
 /// Checks whether a line with the corresponding tag is already allocated (fetch in progress or
 /// already valid)
 bool Cache::isAllocated(Cache::index_t index, Cache::tag_t tag) const
 {
-    return std::find_if(lineTable[index].begin(),
-                        lineTable[index].end(),
-                        [tag](const CacheLine& cacheLine) {
-                            return (cacheLine.tag == tag) && cacheLine.allocated;
-                        }) != lineTable[index].end();
+    return findWay(index, tag, Allocated) != associativity;
 }
 
 /// Process oldest hit in mshrQueue, accept pending request from initiator
@@ -655,36 +791,36 @@ void Cache::processMshrResponse()
     if (!tSocketBackpressure) // TODO: Bedingung eigentlich zu streng, wenn man Hit delay
                               // berücksichtigt.
     {
-        const auto hitIt =
-            std::find_if(mshrQueue.begin(),
-                         mshrQueue.end(),
-                         [this](const Mshr& entry) { return isHit(entry.index, entry.tag); });
+        std::size_t hitPosition =
+            mshrQueue.findIf([this](const Mshr& entry) { return isHit(entry.index, entry.tag); });
 
         // In case there are hits in mshrActive, handle them. Otherwise try again later.
-        if (hitIt == mshrQueue.end())
+        if (hitPosition == mshrQueue.size())
             return;
 
+        Mshr& hitMshr = mshrQueue[hitPosition];
+
         // Another MSHR target already started the modeling of the hit delay.
         // Try again later.
-        if (hitIt->hitDelayStarted && !hitIt->hitDelayAccounted)
+        if (hitMshr.hitDelayStarted && !hitMshr.hitDelayAccounted)
             return;
 
         // Get the first request in the list and respond to it
-        tlm_generic_payload& returnTrans = *hitIt->requestList.front();
-        hitIt->requestList.pop_front();
+        tlm_generic_payload& returnTrans = *hitMshr.requestList.front();
+        hitMshr.requestList.pop_front();
 
-        if (hitIt->hitDelayAccounted)
+        if (hitMshr.hitDelayAccounted)
             accessCacheAndSendResponse(returnTrans);
         else
         {
-            hitIt->hitDelayStarted = true;
+            hitMshr.hitDelayStarted = true;
             payloadEventQueue.notify(returnTrans, MISS_HANDLING, hitLatency);
             return;
         }
 
-        if (hitIt->requestList.empty())
+        if (hitMshr.requestList.empty())
         {
-            mshrQueue.erase(hitIt);
+            mshrQueue.erase(hitPosition);
 
             if (endRequestPending != nullptr && hasBufferSpace())
             {
@@ -713,3 +849,38 @@ sc_time Cache::ceilDelay(const sc_time& inDelay) const
     sc_time outDelay = outTime - sc_time_stamp();
     return outDelay;
 }
+
+void Cache::end_of_simulation()
+{
+    uint64_t numberOfAccesses = numberOfHits + numberOfPrimaryMisses + numberOfSecondaryMisses;
+    double hitRate = numberOfAccesses == 0 ? 0.0
+                                           : static_cast<double>(numberOfHits) /
+                                                 static_cast<double>(numberOfAccesses);
+
+    std::cout << name() << std::string("  HITS:           ") << numberOfHits << " / "
+              << numberOfAccesses << " | " << std::fixed << std::setprecision(2) << std::setw(6)
+              << (hitRate * 100) << " %" << std::endl;
+
+    if (prefetcher)
+    {
+        // Accuracy: share of the prefetched lines that were used by a demand request
+        // Coverage: share of the misses without prefetching that were eliminated
+        uint64_t numberOfMissesWithoutPrefetching =
+            numberOfUsefulPrefetches + numberOfPrimaryMisses;
+        double accuracy = numberOfPrefetches == 0
+                              ? 0.0
+                              : static_cast<double>(numberOfUsefulPrefetches) /
+                                    static_cast<double>(numberOfPrefetches);
+        double coverage = numberOfMissesWithoutPrefetching == 0
+                              ? 0.0
+                              : static_cast<double>(numberOfUsefulPrefetches) /
+                                    static_cast<double>(numberOfMissesWithoutPrefetching);
+
+        std::cout << name() << std::string("  PREFETCHES:     ") << numberOfUsefulPrefetches
+                  << " / " << numberOfPrefetches << " useful" << std::endl;
+        std::cout << name() << std::string("  PF ACCURACY:    ") << std::fixed
+                  << std::setprecision(2) << std::setw(6) << (accuracy * 100) << " %" << std::endl;
+        std::cout << name() << std::string("  PF COVERAGE:    ") << std::fixed
+                  << std::setprecision(2) << std::setw(6) << (coverage * 100) << " %" << std::endl;
+    }
+}
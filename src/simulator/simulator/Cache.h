@@ -37,10 +37,16 @@
 #pragma once
 
 #include "MemoryManager.h"
+#include "RingBuffer.h"
+#include "cache/Prefetcher.h"
+#include "cache/ReplacementPolicy.h"
+
+#include <DRAMSys/config/CacheConfig.h>
 
 #include <cstdint>
-#include <list>
-#include <queue>
+#include <deque>
+#include <memory>
+#include <optional>
 #include <systemc>
 #include <tlm>
 #include <tlm_utils/peq_with_cb_and_phase.h>
@@ -63,10 +69,32 @@ public:
           bool storageEnabled,
           sc_core::sc_time cycleTime,
           std::size_t hitCycles,
+          DRAMSys::Config::ReplacementPolicyType replacementPolicyType,
+          DRAMSys::Config::PrefetcherType prefetcherType,
+          unsigned int prefetchDegree,
+          std::size_t prefetchTableSize,
+          uint64_t memoryOffset,
+          uint64_t memorySize,
           MemoryManager& memoryManager);
     SC_HAS_PROCESS(Cache);
 
+    static constexpr std::size_t DEFAULT_SIZE = 32768;
+    static constexpr std::size_t DEFAULT_ASSOCIATIVITY = 8;
+    static constexpr std::size_t DEFAULT_LINE_SIZE = 64;
+    static constexpr std::size_t DEFAULT_MSHR_DEPTH = 8;
+    static constexpr std::size_t DEFAULT_WRITE_BUFFER_DEPTH = 8;
+    static constexpr std::size_t DEFAULT_MAX_TARGET_LIST_SIZE = 4;
+    static constexpr std::size_t DEFAULT_HIT_CYCLES = 4;
+    static constexpr DRAMSys::Config::ReplacementPolicyType DEFAULT_REPLACEMENT_POLICY =
+        DRAMSys::Config::ReplacementPolicyType::Lru;
+    static constexpr DRAMSys::Config::PrefetcherType DEFAULT_PREFETCHER =
+        DRAMSys::Config::PrefetcherType::None;
+    static constexpr unsigned int DEFAULT_PREFETCH_DEGREE = 1;
+    static constexpr std::size_t DEFAULT_PREFETCH_TABLE_SIZE = 16;
+
 private:
+    void end_of_simulation() override;
+
     void peqCallback(tlm::tlm_generic_payload& trans, const tlm::tlm_phase& phase);
 
     tlm::tlm_sync_enum nb_transport_fw(tlm::tlm_generic_payload& trans,
@@ -106,19 +134,43 @@ private:
     using tag_t = std::uint64_t;
     using lineOffset_t = std::uint64_t;
 
-    struct CacheLine
+    using way_t = std::size_t;
+
+    // The lines are stored as flat arrays with all ways of a set next to each other, so that
+    // the tags of a set can be compared in one sweep over contiguous memory.
+    enum LineFlags : std::uint8_t
     {
-        tag_t tag = 0;
-        unsigned char* dataPtr = nullptr;
-        bool allocated = false;
-        bool valid = false;
-        bool dirty = false;
-        sc_core::sc_time lastAccessTime = sc_core::SC_ZERO_TIME;
+        Allocated = 1U << 0U,
+        Valid = 1U << 1U,
+        Dirty = 1U << 2U,
+        // Brought in by a prefetch and not yet accessed by a demand request
+        Prefetched = 1U << 3U
     };
 
-    std::vector<std::vector<CacheLine>> lineTable;
+    std::vector<tag_t> lineTags;
+    std::vector<std::uint8_t> lineFlags;
     std::vector<uint8_t> dataMemory;
 
+    std::unique_ptr<ReplacementPolicy> replacementPolicy;
+    std::vector<bool> evictionCandidates;
+
+    std::unique_ptr<Prefetcher> prefetcher;
+    std::vector<uint64_t> prefetchAddresses;
+
+    // Prefetches outside the address range of the memory are dropped
+    const uint64_t memoryStart;
+    const uint64_t memoryEnd;
+
+    std::size_t getLine(index_t index, way_t way) const { return index * associativity + way; }
+    unsigned char* getLineData(index_t index, way_t way);
+
+    /// Returns the way of the line with the tag that has all given flags set or associativity.
+    way_t findWay(index_t index, tag_t tag, std::uint8_t flags) const;
+
+    /// Returns whether the line was brought in by a prefetch and clears the flag.
+    bool consumePrefetch(index_t index, way_t way);
+    void issuePrefetches(std::uint64_t lineAddress, bool trigger);
+
     bool isHit(index_t index, tag_t tag) const;
     bool isHit(std::uint64_t address) const;
 
@@ -134,17 +186,18 @@ private:
                   unsigned int dataLength,
                   unsigned char* dataPtr);
 
-    CacheLine* evictLine(index_t index);
+    std::optional<way_t> evictLine(index_t index);
 
     std::tuple<index_t, tag_t, lineOffset_t> decodeAddress(std::uint64_t address) const;
     std::uint64_t encodeAddress(index_t index, tag_t tag, lineOffset_t lineOffset = 0) const;
 
     struct BufferEntry
     {
-        index_t index;
-        tag_t tag;
-        tlm::tlm_generic_payload* trans;
+        index_t index = 0;
+        tag_t tag = 0;
+        tlm::tlm_generic_payload* trans = nullptr;
 
+        BufferEntry() = default;
         BufferEntry(index_t index, tag_t tag, tlm::tlm_generic_payload* trans) :
             index(index),
             tag(tag),
@@ -155,9 +208,9 @@ private:
 
     struct Mshr
     {
-        index_t index;
-        tag_t tag;
-        std::list<tlm::tlm_generic_payload*> requestList;
+        index_t index = 0;
+        tag_t tag = 0;
+        RingBuffer<tlm::tlm_generic_payload*> requestList;
 
         /// Whether the Mshr entry was already issued to the target.
         bool issued = false;
@@ -172,23 +225,35 @@ private:
         /// delay when it is already being waited on.
         bool hitDelayStarted = false;
 
-        Mshr(index_t index, tag_t tag, tlm::tlm_generic_payload* request) :
-            index(index),
-            tag(tag),
-            requestList{request}
+        explicit Mshr(std::size_t maxTargetListSize) : requestList(maxTargetListSize) {}
+
+        /// Prefetches allocate entries without a request.
+        void reset(index_t index, tag_t tag, tlm::tlm_generic_payload* request)
         {
+            this->index = index;
+            this->tag = tag;
+            while (!requestList.empty())
+                requestList.pop_front();
+            if (request != nullptr)
+                requestList.push_back(request);
+            issued = false;
+            hitDelayAccounted = false;
+            hitDelayStarted = false;
         }
     };
 
-    std::deque<Mshr> mshrQueue;
-    std::deque<BufferEntry> hitQueue;
+    /// Returns the position of the MSHR entry for the line or mshrQueue.size().
+    std::size_t findMshr(index_t index, tag_t tag) const;
 
-    using WriteBuffer = std::list<BufferEntry>;
-    WriteBuffer writeBuffer;
+    RingBuffer<Mshr> mshrQueue;
+    std::deque<BufferEntry> hitQueue;
+    RingBuffer<BufferEntry> writeBuffer;
 
     uint64_t numberOfHits = 0;
     uint64_t numberOfPrimaryMisses = 0;
     uint64_t numberOfSecondaryMisses = 0;
+    uint64_t numberOfPrefetches = 0;
+    uint64_t numberOfUsefulPrefetches = 0;
 
     std::uint64_t getAlignedAddress(std::uint64_t address) const;
 
@@ -209,7 +274,7 @@ private:
 
     void fillLine(tlm::tlm_generic_payload& trans);
     void accessCacheAndSendResponse(tlm::tlm_generic_payload& trans);
-    static void allocateLine(CacheLine* line, tag_t tag);
+    void allocateLine(index_t index, way_t way, tag_t tag);
 
     bool isAllocated(index_t index, tag_t tag) const;
     bool hasBufferSpace() const;
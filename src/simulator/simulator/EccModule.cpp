@@ -252,7 +252,7 @@ tlm::tlm_generic_payload* EccModule::generateEccPayload(DRAMSys::DecodedAddress
     decodedAddress.column = eccColumn;
     uint64_t eccAddress = addressDecoder.encodeAddress(decodedAddress);
 
-    tlm_generic_payload& payload = memoryManager.allocate(32);
+    tlm_generic_payload& payload = memoryManager.allocate(32, false);
     payload.acquire();
     payload.set_address(eccAddress);
     payload.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
@@ -35,7 +35,7 @@
 
 #pragma once
 
-#include <tlm_utils/multi_socket_bases.h>
+#include <tlm>
 
 class Initiator
 {
@@ -49,6 +49,6 @@ public:
     Initiator() = default;
     virtual ~Initiator() = default;
 
-    virtual void bind(tlm_utils::multi_target_base<>& target) = 0;
+    virtual void bind(tlm::tlm_base_target_socket_b<>& target) = 0;
     virtual uint64_t totalRequests() = 0;
 };
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Interconnect.h"
+
+using namespace sc_core;
+using namespace tlm;
+
+Interconnect::Interconnect(const sc_module_name& name) :
+    sc_module(name),
+    payloadEventQueue(this, &Interconnect::peqCallback)
+{
+    tSocket.register_nb_transport_fw(this, &Interconnect::nb_transport_fw);
+    tSocket.register_transport_dbg(this, &Interconnect::transport_dbg);
+    iSocket.register_nb_transport_bw(this, &Interconnect::nb_transport_bw);
+}
+
+tlm_sync_enum Interconnect::nb_transport_fw(int id,
+                                            tlm_generic_payload& trans,
+                                            tlm_phase& phase,
+                                            sc_time& fwDelay) // initiator side --->
+{
+    if (phase == BEGIN_REQ)
+        initiatorOfPayload[&trans] = id;
+
+    payloadEventQueue.notify(trans, phase, fwDelay);
+    return TLM_ACCEPTED;
+}
+
+tlm_sync_enum Interconnect::nb_transport_bw(tlm_generic_payload& trans,
+                                            tlm_phase& phase,
+                                            sc_time& bwDelay) // <--- target side
+{
+    payloadEventQueue.notify(trans, phase, bwDelay);
+    return TLM_ACCEPTED;
+}
+
+unsigned int Interconnect::transport_dbg([[maybe_unused]] int id, tlm_generic_payload& trans)
+{
+    return iSocket->transport_dbg(trans);
+}
+
+void Interconnect::peqCallback(tlm_generic_payload& trans, const tlm_phase& phase)
+{
+    if (phase == BEGIN_REQ) // initiator side --->
+    {
+        pendingRequests.push_back(&trans);
+        sendNextRequest();
+    }
+    else if (phase == END_REQ) // <--- target side
+    {
+        sendToInitiator(trans, END_REQ);
+        requestInProgress = nullptr;
+        sendNextRequest();
+    }
+    else if (phase == BEGIN_RESP) // <--- target side
+    {
+        // BEGIN_RESP implies END_REQ for both the target and the initiator
+        bool implicitEndRequest = &trans == requestInProgress;
+        sendToInitiator(trans, BEGIN_RESP);
+
+        if (implicitEndRequest)
+        {
+            requestInProgress = nullptr;
+            sendNextRequest();
+        }
+    }
+    else if (phase == END_RESP) // initiator side --->
+    {
+        initiatorOfPayload.erase(&trans);
+
+        tlm_phase fwPhase = END_RESP;
+        sc_time fwDelay = SC_ZERO_TIME;
+        iSocket->nb_transport_fw(trans, fwPhase, fwDelay);
+    }
+    else
+    {
+        SC_REPORT_FATAL("Interconnect", "PEQ was triggered with unknown phase");
+    }
+}
+
+void Interconnect::sendNextRequest()
+{
+    if (requestInProgress != nullptr || pendingRequests.empty())
+        return;
+
+    requestInProgress = pendingRequests.front();
+    pendingRequests.pop_front();
+
+    tlm_phase fwPhase = BEGIN_REQ;
+    sc_time fwDelay = SC_ZERO_TIME;
+    tlm_sync_enum returnValue = iSocket->nb_transport_fw(*requestInProgress, fwPhase, fwDelay);
+
+    if (returnValue == TLM_UPDATED)
+        payloadEventQueue.notify(*requestInProgress, fwPhase, fwDelay);
+}
+
+void Interconnect::sendToInitiator(tlm_generic_payload& trans, tlm_phase phase)
+{
+    int id = initiatorOfPayload.at(&trans);
+    sc_time bwDelay = SC_ZERO_TIME;
+    tlm_sync_enum returnValue = tSocket[id]->nb_transport_bw(trans, phase, bwDelay);
+
+    if (returnValue == TLM_UPDATED)
+        payloadEventQueue.notify(trans, phase, bwDelay);
+}
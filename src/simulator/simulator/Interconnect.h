@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <deque>
+#include <systemc>
+#include <tlm>
+#include <tlm_utils/multi_passthrough_target_socket.h>
+#include <tlm_utils/peq_with_cb_and_phase.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <unordered_map>
+
+/// Connects several initiators to a target that only accepts a single binding, e.g., a shared
+/// cache or the ECC module. Requests are forwarded one at a time in order of arrival, responses
+/// are routed back to the initiator that issued the request.
+class Interconnect : public sc_core::sc_module
+{
+public:
+    tlm_utils::multi_passthrough_target_socket<Interconnect> tSocket;
+    tlm_utils::simple_initiator_socket<Interconnect> iSocket;
+
+    explicit Interconnect(const sc_core::sc_module_name& name);
+    SC_HAS_PROCESS(Interconnect);
+
+private:
+    tlm::tlm_sync_enum nb_transport_fw(int id,
+                                       tlm::tlm_generic_payload& trans,
+                                       tlm::tlm_phase& phase,
+                                       sc_core::sc_time& fwDelay);
+    tlm::tlm_sync_enum nb_transport_bw(tlm::tlm_generic_payload& trans,
+                                       tlm::tlm_phase& phase,
+                                       sc_core::sc_time& bwDelay);
+    unsigned int transport_dbg(int id, tlm::tlm_generic_payload& trans);
+
+    void peqCallback(tlm::tlm_generic_payload& trans, const tlm::tlm_phase& phase);
+    void sendNextRequest();
+    void sendToInitiator(tlm::tlm_generic_payload& trans, tlm::tlm_phase phase);
+
+    tlm_utils::peq_with_cb_and_phase<Interconnect> payloadEventQueue;
+
+    std::unordered_map<tlm::tlm_generic_payload*, int> initiatorOfPayload;
+    std::deque<tlm::tlm_generic_payload*> pendingRequests;
+
+    // Request to the target whose END_REQ is outstanding
+    tlm::tlm_generic_payload* requestInProgress = nullptr;
+};
@@ -38,25 +38,42 @@
 
 #include "DRAMSys/common/DebugManager.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
 using namespace tlm;
 
+static constexpr std::size_t alignUp(std::size_t size, std::size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
 MemoryManager::MemoryManager(bool storageEnabled) : storageEnabled(storageEnabled)
 {
 }
 
 MemoryManager::~MemoryManager()
 {
-    for (auto& innerBuffer : freePayloads)
+    for (unsigned sizeClass = 0; sizeClass < sizeClasses.size(); sizeClass++)
     {
-        while (!innerBuffer.second.empty())
+        auto const& chunks = sizeClasses[sizeClass].chunks;
+
+        for (std::size_t chunk = 0; chunk < chunks.size(); chunk++)
         {
-            tlm_generic_payload* payload = innerBuffer.second.top();
-            if (storageEnabled)
-                delete[] payload->get_data_ptr();
-            payload->reset();
-            delete payload;
-            innerBuffer.second.pop();
-            numberOfFrees++;
+            // Only the last chunk may be partially used
+            unsigned usedSlots = chunk + 1 == chunks.size()
+                                     ? sizeClasses[sizeClass].slotsUsedInChunk
+                                     : slotsPerChunk(sizeClass);
+
+            for (unsigned slot = 0; slot < usedSlots; slot++)
+            {
+                auto* payload = std::launder(reinterpret_cast<PooledPayload*>(
+                    chunks[chunk].get() + slot * slotSize(sizeClass)));
+                payload->reset();
+                payload->~PooledPayload();
+                numberOfFrees++;
+            }
         }
     }
 
@@ -66,31 +83,65 @@ MemoryManager::~MemoryManager()
     // " + to_string(numberOfFrees));
 }
 
-tlm_generic_payload& MemoryManager::allocate(unsigned dataLength)
+std::size_t MemoryManager::slotSize(unsigned sizeClass) const
 {
-    if (freePayloads[dataLength].empty())
-    {
-        numberOfAllocations++;
-        auto* payload = new tlm_generic_payload(this);
+    std::size_t payloadSize = alignUp(sizeof(PooledPayload), alignof(std::max_align_t));
+    std::size_t dataSize = storageEnabled ? sizeClass * SIZE_CLASS_GRANULARITY : 0;
+    return alignUp(payloadSize + dataSize, alignof(std::max_align_t));
+}
 
-        if (storageEnabled)
-        {
-            // Allocate a data buffer and initialize it with zeroes:
-            auto* data = new unsigned char[dataLength];
-            std::fill(data, data + dataLength, 0);
-            payload->set_data_ptr(data);
-        }
+unsigned MemoryManager::slotsPerChunk(unsigned sizeClass) const
+{
+    return static_cast<unsigned>(std::max<std::size_t>(CHUNK_SIZE / slotSize(sizeClass), 1));
+}
+
+tlm_generic_payload& MemoryManager::allocate(unsigned dataLength, bool initializeData)
+{
+    // Without storage, all payloads share the same size class as they carry no data
+    unsigned sizeClass =
+        storageEnabled ? (dataLength + SIZE_CLASS_GRANULARITY - 1) / SIZE_CLASS_GRANULARITY : 0;
 
+    if (sizeClass >= sizeClasses.size())
+        sizeClasses.resize(sizeClass + 1);
+
+    SizeClass& pool = sizeClasses[sizeClass];
+
+    if (!pool.freePayloads.empty())
+    {
+        PooledPayload* payload = pool.freePayloads.back();
+        pool.freePayloads.pop_back();
         return *payload;
     }
 
-    tlm_generic_payload* result = freePayloads[dataLength].top();
-    freePayloads[dataLength].pop();
-    return *result;
+    // Carve a new payload from the current chunk of this size class
+    if (pool.chunks.empty() || pool.slotsUsedInChunk == slotsPerChunk(sizeClass))
+    {
+        // The chunk is intentionally left uninitialized
+        pool.chunks.emplace_back(new unsigned char[slotsPerChunk(sizeClass) * slotSize(sizeClass)]);
+        pool.slotsUsedInChunk = 0;
+    }
+
+    unsigned char* slot = pool.chunks.back().get() + pool.slotsUsedInChunk * slotSize(sizeClass);
+    pool.slotsUsedInChunk++;
+    numberOfAllocations++;
+
+    auto* payload = new (slot) PooledPayload(this, sizeClass);
+
+    if (storageEnabled)
+    {
+        unsigned char* data = slot + alignUp(sizeof(PooledPayload), alignof(std::max_align_t));
+
+        if (initializeData)
+            std::fill(data, data + sizeClass * SIZE_CLASS_GRANULARITY, 0);
+
+        payload->set_data_ptr(data);
+    }
+
+    return *payload;
 }
 
 void MemoryManager::free(tlm_generic_payload* payload)
 {
-    unsigned dataLength = payload->get_data_length();
-    freePayloads[dataLength].push(payload);
+    auto* pooledPayload = static_cast<PooledPayload*>(payload);
+    sizeClasses[pooledPayload->sizeClass].freePayloads.push_back(pooledPayload);
 }
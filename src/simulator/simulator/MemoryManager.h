@@ -38,10 +38,12 @@
 #ifndef MEMORYMANAGER_H
 #define MEMORYMANAGER_H
 
-#include <stack>
+#include <memory>
 #include <tlm>
-#include <unordered_map>
+#include <vector>
 
+// Payloads and their data buffers are carved from contiguous chunks, one set of chunks per size
+// class. The data buffer of a payload is located directly behind the payload itself.
 class MemoryManager : public tlm::tlm_mm_interface
 {
 public:
@@ -52,13 +54,41 @@ public:
     MemoryManager& operator=(MemoryManager&&) = delete;
     ~MemoryManager() override;
 
-    tlm::tlm_generic_payload& allocate(unsigned dataLength);
+    // The data buffer of a newly created payload is only initialized with zeroes if requested,
+    // e.g., read payloads are overwritten by the target anyway. Recycled payloads keep their
+    // previous data.
+    tlm::tlm_generic_payload& allocate(unsigned dataLength, bool initializeData = true);
     void free(tlm::tlm_generic_payload* payload) override;
 
 private:
+    class PooledPayload : public tlm::tlm_generic_payload
+    {
+    public:
+        PooledPayload(tlm::tlm_mm_interface* mm, unsigned sizeClass) :
+            tlm_generic_payload(mm),
+            sizeClass(sizeClass)
+        {
+        }
+
+        const unsigned sizeClass;
+    };
+
+    struct SizeClass
+    {
+        std::vector<std::unique_ptr<unsigned char[]>> chunks;
+        std::vector<PooledPayload*> freePayloads;
+        unsigned slotsUsedInChunk = 0;
+    };
+
+    static constexpr unsigned SIZE_CLASS_GRANULARITY = 16;
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    std::size_t slotSize(unsigned sizeClass) const;
+    unsigned slotsPerChunk(unsigned sizeClass) const;
+
     uint64_t numberOfAllocations = 0;
     uint64_t numberOfFrees = 0;
-    std::unordered_map<unsigned, std::stack<tlm::tlm_generic_payload*>> freePayloads;
+    std::vector<SizeClass> sizeClasses;
     bool storageEnabled = false;
 };
 
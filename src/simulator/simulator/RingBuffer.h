@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/// A FIFO of fixed capacity that never allocates after construction. The slots are reused, so
+/// entries that own resources (e.g., nested ring buffers) keep them when they are popped.
+template <typename T> class RingBuffer
+{
+public:
+    explicit RingBuffer(std::size_t capacity = 0, const T& value = T()) :
+        buffer(capacity, value)
+    {
+    }
+
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] bool full() const { return count == buffer.size(); }
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] std::size_t capacity() const { return buffer.size(); }
+
+    /// Access in FIFO order, the front is at position 0.
+    T& operator[](std::size_t position) { return buffer[slot(position)]; }
+    const T& operator[](std::size_t position) const { return buffer[slot(position)]; }
+
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[count - 1]; }
+    const T& back() const { return (*this)[count - 1]; }
+
+    /// Appends the next free slot and returns it. The slot still holds its previous content
+    /// and has to be reinitialized by the caller.
+    T& allocateBack()
+    {
+        assert(!full());
+        count++;
+        return back();
+    }
+
+    void push_back(const T& value) { allocateBack() = value; }
+
+    void pop_front()
+    {
+        assert(!empty());
+        head = slot(1);
+        count--;
+    }
+
+    /// Removes an entry while keeping the order of the others. The removed slot is moved
+    /// behind the last entry by swapping so that no slot loses its resources.
+    void erase(std::size_t position)
+    {
+        assert(position < count);
+        for (std::size_t i = position; i + 1 < count; i++)
+            std::swap((*this)[i], (*this)[i + 1]);
+        count--;
+    }
+
+    /// Returns the position of the first entry that fulfills the predicate or size().
+    template <typename Predicate> [[nodiscard]] std::size_t findIf(Predicate predicate) const
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            if (predicate((*this)[i]))
+                return i;
+        }
+        return count;
+    }
+
+private:
+    [[nodiscard]] std::size_t slot(std::size_t position) const
+    {
+        std::size_t index = head + position;
+        return index < buffer.size() ? index : index - buffer.size();
+    }
+
+    std::vector<T> buffer;
+    std::size_t head = 0;
+    std::size_t count = 0;
+};
@@ -62,7 +62,7 @@ public:
     {
     }
 
-    void bind(tlm_utils::multi_target_base<>& target) override { issuer.iSocket.bind(target); }
+    void bind(tlm::tlm_base_target_socket_b<>& target) override { issuer.iSocket.bind(target); }
     uint64_t totalRequests() override { return producer.totalRequests(); };
 
 private:
@@ -41,13 +41,18 @@
 #include "player/StlPlayer.h"
 #include "util.h"
 
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
 Simulator::Simulator(DRAMSys::Config::Configuration configuration,
                      std::filesystem::path resourceDirectory) :
     storageEnabled(configuration.simconfig.StoreMode == DRAMSys::Config::StoreModeType::Store),
     memoryManager(storageEnabled),
     configuration(std::move(configuration)),
     resourceDirectory(std::move(resourceDirectory)),
-    dramSys(std::make_unique<DRAMSys::DRAMSys>("DRAMSys", this->configuration))
+    dramSys(std::make_unique<DRAMSys::DRAMSys>("DRAMSys",
+                                               dramSysConfiguration(this->configuration)))
 {
     terminateInitiator = [this]()
     {
@@ -71,15 +76,142 @@ Simulator::Simulator(DRAMSys::Config::Configuration configuration,
         std::abort(); // Silence warning
     }
 
+    // Build the shared part of the memory hierarchy from DRAMSys upwards
+    tlm::tlm_base_target_socket_b<>* sharedTarget = &dramSys->tSocket;
+
+    if (this->configuration.simconfig.EccModule.value_or(false))
+    {
+        eccModule = std::make_unique<EccModule>("EccModule", dramSys->getAddressDecoder());
+        eccModule->iSocket.bind(*sharedTarget);
+        sharedTarget = &eccModule->tSocket;
+    }
+
+    if (const auto& cacheConfig = this->configuration.simconfig.LastLevelCache)
+    {
+        lastLevelCache =
+            instantiateCache("LastLevelCache", *cacheConfig, dramSys->getMemSpec().tCK);
+        lastLevelCache->iSocket.bind(*sharedTarget);
+        sharedTarget = &lastLevelCache->tSocket;
+    }
+
+    if (hasSharedModules(this->configuration))
+    {
+        bool qosConfigured = std::any_of(
+            this->configuration.tracesetup->begin(),
+            this->configuration.tracesetup->end(),
+            [](const DRAMSys::Config::Initiator& initiator)
+            {
+                return std::visit(
+                    [](auto&& config)
+                    {
+                        return config.priority.has_value() || config.weight.has_value() ||
+                               config.deadline.has_value();
+                    },
+                    initiator);
+            });
+
+        if (qosConfigured)
+        {
+            SC_REPORT_WARNING("Simulator",
+                              "QoS settings of the initiators are not passed on to DRAMSys behind "
+                              "a shared last-level cache or ECC module");
+        }
+
+        // The shared modules accept only a single binding
+        if (this->configuration.tracesetup->size() > 1)
+        {
+            interconnect = std::make_unique<Interconnect>("Interconnect");
+            interconnect->iSocket.bind(*sharedTarget);
+            sharedTarget = &interconnect->tSocket;
+        }
+    }
+
     for (const auto& initiatorConfig : *this->configuration.tracesetup)
     {
         auto initiator = instantiateInitiator(initiatorConfig);
         totalTransactions += initiator->totalRequests();
-        initiator->bind(dramSys->tSocket);
+
+        auto [name, clkMhz, cacheConfig] = std::visit(
+            [](auto&& config) { return std::make_tuple(config.name, config.clkMhz, config.cache); },
+            initiatorConfig);
+
+        if (cacheConfig.has_value())
+        {
+            sc_core::sc_time cycleTime(1.0 / static_cast<double>(clkMhz), sc_core::SC_US);
+            auto cache = instantiateCache(name + "_cache", *cacheConfig, cycleTime);
+            initiator->bind(cache->tSocket);
+            cache->iSocket.bind(*sharedTarget);
+            privateCaches.push_back(std::move(cache));
+        }
+        else
+        {
+            initiator->bind(*sharedTarget);
+        }
+
         initiators.push_back(std::move(initiator));
     }
 }
 
+DRAMSys::Config::Configuration
+Simulator::dramSysConfiguration(const DRAMSys::Config::Configuration& configuration)
+{
+    DRAMSys::Config::Configuration dramSysConfiguration = configuration;
+
+    // Behind a shared module, DRAMSys sees the merged traffic of all initiators as a single
+    // initiator. Otherwise, the QoS settings of the first initiator would apply to all requests.
+    if (hasSharedModules(configuration) && dramSysConfiguration.tracesetup.has_value())
+    {
+        for (auto& initiator : *dramSysConfiguration.tracesetup)
+        {
+            std::visit(
+                [](auto&& config)
+                {
+                    config.priority.reset();
+                    config.weight.reset();
+                    config.deadline.reset();
+                },
+                initiator);
+        }
+    }
+
+    return dramSysConfiguration;
+}
+
+bool Simulator::hasSharedModules(const DRAMSys::Config::Configuration& configuration)
+{
+    return configuration.simconfig.EccModule.value_or(false) ||
+           configuration.simconfig.LastLevelCache.has_value();
+}
+
+std::unique_ptr<Cache> Simulator::instantiateCache(const std::string& name,
+                                                   const DRAMSys::Config::CacheConfig& config,
+                                                   sc_core::sc_time defaultCycleTime)
+{
+    sc_core::sc_time cycleTime =
+        config.ClkMhz.has_value()
+            ? sc_core::sc_time(1.0 / static_cast<double>(*config.ClkMhz), sc_core::SC_US)
+            : defaultCycleTime;
+
+    return std::make_unique<Cache>(
+        name.c_str(),
+        config.Size.value_or(Cache::DEFAULT_SIZE),
+        config.Associativity.value_or(Cache::DEFAULT_ASSOCIATIVITY),
+        config.LineSize.value_or(Cache::DEFAULT_LINE_SIZE),
+        config.MshrDepth.value_or(Cache::DEFAULT_MSHR_DEPTH),
+        config.WriteBufferDepth.value_or(Cache::DEFAULT_WRITE_BUFFER_DEPTH),
+        config.MaxTargetListSize.value_or(Cache::DEFAULT_MAX_TARGET_LIST_SIZE),
+        storageEnabled,
+        cycleTime,
+        config.HitCycles.value_or(Cache::DEFAULT_HIT_CYCLES),
+        config.ReplacementPolicy.value_or(Cache::DEFAULT_REPLACEMENT_POLICY),
+        config.Prefetcher.value_or(Cache::DEFAULT_PREFETCHER),
+        config.PrefetchDegree.value_or(Cache::DEFAULT_PREFETCH_DEGREE),
+        config.PrefetchTableSize.value_or(Cache::DEFAULT_PREFETCH_TABLE_SIZE),
+        configuration.simconfig.AddressOffset.value_or(0),
+        dramSys->getMemSpec().getSimMemSizeInBytes(),
+        memoryManager);
+}
+
 std::unique_ptr<Initiator>
 Simulator::instantiateInitiator(const DRAMSys::Config::Initiator& initiator)
 {
@@ -97,6 +229,7 @@ Simulator::instantiateInitiator(const DRAMSys::Config::Initiator& initiator)
                                                           memoryManager,
                                                           memorySize,
                                                           defaultDataLength,
+                                                          dramSys->getAddressDecoder(),
                                                           finishTransaction,
                                                           terminateInitiator);
             }
@@ -118,11 +251,30 @@ Simulator::instantiateInitiator(const DRAMSys::Config::Initiator& initiator)
                     SC_REPORT_FATAL("Simulator", report.c_str());
                 }
 
+                // Players that replay the same trace file share one parsed copy of it
+                auto playersOfTrace = std::count_if(
+                    configuration.tracesetup->cbegin(),
+                    configuration.tracesetup->cend(),
+                    [&config](const DRAMSys::Config::Initiator& other)
+                    {
+                        const auto* player = std::get_if<DRAMSys::Config::TracePlayer>(&other);
+                        return player != nullptr && player->name == config.name;
+                    });
+
                 StlPlayer player(tracePath.c_str(),
                                  config.clkMhz,
                                  defaultDataLength,
                                  *traceType,
-                                 storageEnabled);
+                                 storageEnabled,
+                                 config.loops.value_or(1),
+                                 config.timeScale.value_or(1.0),
+                                 config.addressOffset.value_or(0),
+                                 config.addressMask.value_or(std::numeric_limits<uint64_t>::max()),
+                                 config.predecodeAddresses.value_or(false)
+                                     ? &dramSys->getAddressDecoder()
+                                     : nullptr,
+                                 configuration.simconfig.AddressOffset.value_or(0),
+                                 playersOfTrace > 1);
 
                 return std::make_unique<SimpleInitiator<StlPlayer>>(config.name.c_str(),
                                                                     memoryManager,
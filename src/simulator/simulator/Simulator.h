@@ -35,7 +35,10 @@
 
 #pragma once
 
+#include "Cache.h"
+#include "EccModule.h"
 #include "Initiator.h"
+#include "Interconnect.h"
 #include "MemoryManager.h"
 
 #include <DRAMSys/config/DRAMSysConfiguration.h>
@@ -52,7 +55,14 @@ public:
     static void run();
 
 private:
+    static DRAMSys::Config::Configuration
+    dramSysConfiguration(const DRAMSys::Config::Configuration& configuration);
+    static bool hasSharedModules(const DRAMSys::Config::Configuration& configuration);
+
     std::unique_ptr<Initiator> instantiateInitiator(const DRAMSys::Config::Initiator& initiator);
+    std::unique_ptr<Cache> instantiateCache(const std::string& name,
+                                            const DRAMSys::Config::CacheConfig& config,
+                                            sc_core::sc_time defaultCycleTime);
 
     const bool storageEnabled;
     MemoryManager memoryManager;
@@ -63,6 +73,13 @@ private:
     std::unique_ptr<DRAMSys::DRAMSys> dramSys;
     std::vector<std::unique_ptr<Initiator>> initiators;
 
+    // Optional modules between the initiators and DRAMSys:
+    // initiator -> private cache -> interconnect -> last-level cache -> ECC module -> DRAMSys
+    std::vector<std::unique_ptr<Cache>> privateCaches;
+    std::unique_ptr<Interconnect> interconnect;
+    std::unique_ptr<Cache> lastLevelCache;
+    std::unique_ptr<EccModule> eccModule;
+
     std::function<void()> terminateInitiator;
     std::function<void()> finishTransaction;
 
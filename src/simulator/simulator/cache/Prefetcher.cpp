@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Prefetcher.h"
+
+#include <systemc>
+
+Prefetcher::Prefetcher(uint64_t lineSize, unsigned int degree) :
+    lineSize(lineSize),
+    degree(degree)
+{
+}
+
+NextLinePrefetcher::NextLinePrefetcher(uint64_t lineSize, unsigned int degree) :
+    Prefetcher(lineSize, degree)
+{
+}
+
+void NextLinePrefetcher::access(uint64_t lineAddress,
+                                bool trigger,
+                                std::vector<uint64_t>& prefetches)
+{
+    if (!trigger)
+        return;
+
+    for (unsigned int i = 1; i <= degree; i++)
+        prefetches.push_back(lineAddress + i * lineSize);
+}
+
+StridePrefetcher::StridePrefetcher(uint64_t lineSize, unsigned int degree, std::size_t tableSize) :
+    Prefetcher(lineSize, degree),
+    table(tableSize)
+{
+    if (tableSize == 0)
+        SC_REPORT_FATAL("StridePrefetcher", "Table size must be greater than zero!");
+}
+
+void StridePrefetcher::access(uint64_t lineAddress,
+                              [[maybe_unused]] bool trigger,
+                              std::vector<uint64_t>& prefetches)
+{
+    // Strides are trained on all accesses, otherwise prefetch hits would break the pattern
+    uint64_t region = lineAddress >> REGION_SHIFT;
+    Entry& entry = table[region % table.size()];
+
+    if (entry.region != region)
+    {
+        entry = {region, lineAddress, 0, 0};
+        return;
+    }
+
+    auto stride = static_cast<int64_t>(lineAddress - entry.lastAddress);
+    if (stride == 0)
+        return;
+
+    if (stride == entry.stride)
+    {
+        if (entry.confidence < MAX_CONFIDENCE)
+            entry.confidence++;
+    }
+    else
+    {
+        if (entry.confidence > 0)
+            entry.confidence--;
+        if (entry.confidence == 0)
+            entry.stride = stride;
+    }
+
+    entry.lastAddress = lineAddress;
+
+    if (entry.confidence >= CONFIDENCE_THRESHOLD)
+    {
+        for (unsigned int i = 1; i <= degree; i++)
+        {
+            // Negative strides must not wrap around the start of the address space
+            if (entry.stride < 0 && lineAddress < static_cast<uint64_t>(-entry.stride) * i)
+                break;
+
+            prefetches.push_back(lineAddress + static_cast<uint64_t>(entry.stride) * i);
+        }
+    }
+}
+
+StreamPrefetcher::StreamPrefetcher(uint64_t lineSize, unsigned int degree, std::size_t tableSize) :
+    Prefetcher(lineSize, degree),
+    streams(tableSize)
+{
+    if (tableSize == 0)
+        SC_REPORT_FATAL("StreamPrefetcher", "Table size must be greater than zero!");
+}
+
+void StreamPrefetcher::access(uint64_t lineAddress,
+                              bool trigger,
+                              std::vector<uint64_t>& prefetches)
+{
+    if (!trigger)
+        return;
+
+    numberOfAccesses++;
+    uint64_t window = WINDOW_LINES * lineSize;
+
+    Stream* stream = nullptr;
+    Stream* replacement = &streams.front();
+    for (auto& candidate : streams)
+    {
+        if (candidate.valid && lineAddress != candidate.lastAddress &&
+            lineAddress + window >= candidate.lastAddress &&
+            lineAddress <= candidate.lastAddress + window)
+        {
+            stream = &candidate;
+            break;
+        }
+
+        if (!candidate.valid || (replacement->valid && candidate.lastUse < replacement->lastUse))
+            replacement = &candidate;
+    }
+
+    if (stream == nullptr)
+    {
+        *replacement = {true, lineAddress, 0, 0, numberOfAccesses};
+        return;
+    }
+
+    int direction = lineAddress > stream->lastAddress ? 1 : -1;
+    if (direction == stream->direction)
+        stream->confidence++;
+    else
+    {
+        stream->direction = direction;
+        stream->confidence = 1;
+    }
+
+    stream->lastAddress = lineAddress;
+    stream->lastUse = numberOfAccesses;
+
+    if (stream->confidence >= CONFIDENCE_THRESHOLD)
+    {
+        stream->confidence = CONFIDENCE_THRESHOLD;
+        for (unsigned int i = 1; i <= degree; i++)
+        {
+            if (direction < 0 && lineAddress < i * lineSize)
+                break;
+
+            prefetches.push_back(direction > 0 ? lineAddress + i * lineSize
+                                               : lineAddress - i * lineSize);
+        }
+    }
+}
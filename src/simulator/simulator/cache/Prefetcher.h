@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Observes the demand accesses of a cache and proposes lines to prefetch. The cache issues the
+/// proposed lines through its MSHRs and drops lines that are already present or in flight.
+class Prefetcher
+{
+public:
+    virtual ~Prefetcher() = default;
+
+    /// Called for each accepted demand access. A trigger is a miss or the first hit to a line
+    /// that was brought in by a prefetch. Line addresses to prefetch are appended to prefetches;
+    /// addresses outside the memory are dropped by the cache.
+    virtual void access(uint64_t lineAddress, bool trigger, std::vector<uint64_t>& prefetches) = 0;
+
+protected:
+    Prefetcher(uint64_t lineSize, unsigned int degree);
+
+    const uint64_t lineSize;
+
+    // Number of lines that are prefetched at once.
+    const unsigned int degree;
+};
+
+/// Prefetches the following lines on every trigger.
+class NextLinePrefetcher final : public Prefetcher
+{
+public:
+    NextLinePrefetcher(uint64_t lineSize, unsigned int degree);
+
+    void access(uint64_t lineAddress, bool trigger, std::vector<uint64_t>& prefetches) override;
+};
+
+/// Detects constant strides within memory regions. Without program counters in the payloads,
+/// the accesses are correlated by the region they fall into instead of the instruction.
+class StridePrefetcher final : public Prefetcher
+{
+public:
+    StridePrefetcher(uint64_t lineSize, unsigned int degree, std::size_t tableSize);
+
+    void access(uint64_t lineAddress, bool trigger, std::vector<uint64_t>& prefetches) override;
+
+private:
+    static constexpr unsigned int REGION_SHIFT = 12;
+    static constexpr uint8_t MAX_CONFIDENCE = 3;
+    static constexpr uint8_t CONFIDENCE_THRESHOLD = 2;
+
+    struct Entry
+    {
+        uint64_t region = UINT64_MAX;
+        uint64_t lastAddress = 0;
+        int64_t stride = 0;
+        uint8_t confidence = 0;
+    };
+
+    std::vector<Entry> table;
+};
+
+/// Tracks ascending and descending streams of misses within a window of lines and runs ahead
+/// of confirmed streams.
+class StreamPrefetcher final : public Prefetcher
+{
+public:
+    StreamPrefetcher(uint64_t lineSize, unsigned int degree, std::size_t tableSize);
+
+    void access(uint64_t lineAddress, bool trigger, std::vector<uint64_t>& prefetches) override;
+
+private:
+    static constexpr uint64_t WINDOW_LINES = 16;
+    static constexpr uint8_t CONFIDENCE_THRESHOLD = 2;
+
+    struct Stream
+    {
+        bool valid = false;
+        uint64_t lastAddress = 0;
+        int direction = 0;
+        uint8_t confidence = 0;
+        uint64_t lastUse = 0;
+    };
+
+    std::vector<Stream> streams;
+    uint64_t numberOfAccesses = 0;
+};
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ReplacementPolicy.h"
+
+#include <algorithm>
+#include <systemc>
+
+ReplacementPolicy::ReplacementPolicy(std::size_t numberOfSets, std::size_t associativity) :
+    numberOfSets(numberOfSets),
+    associativity(associativity)
+{
+}
+
+LruPolicy::LruPolicy(std::size_t numberOfSets, std::size_t associativity) :
+    ReplacementPolicy(numberOfSets, associativity),
+    recency(numberOfSets * associativity)
+{
+    if (associativity > 256)
+        SC_REPORT_FATAL("LruPolicy", "Associativity must not exceed 256!");
+
+    for (std::size_t set = 0; set < numberOfSets; set++)
+    {
+        for (std::size_t way = 0; way < associativity; way++)
+            recency[set * associativity + way] = static_cast<std::uint8_t>(way);
+    }
+}
+
+void LruPolicy::touch(std::size_t set, std::size_t way)
+{
+    std::uint8_t* setRecency = recency.data() + set * associativity;
+    std::uint8_t wayRecency = setRecency[way];
+
+    for (std::size_t otherWay = 0; otherWay < associativity; otherWay++)
+    {
+        if (setRecency[otherWay] < wayRecency)
+            setRecency[otherWay]++;
+    }
+
+    setRecency[way] = 0;
+}
+
+void LruPolicy::insert(std::size_t set, std::size_t way)
+{
+    touch(set, way);
+}
+
+std::size_t LruPolicy::getVictim(std::size_t set, const std::vector<bool>& candidates)
+{
+    const std::uint8_t* setRecency = recency.data() + set * associativity;
+    std::size_t victim = associativity;
+
+    for (std::size_t way = 0; way < associativity; way++)
+    {
+        if (candidates[way] && (victim == associativity || setRecency[way] > setRecency[victim]))
+            victim = way;
+    }
+
+    return victim;
+}
+
+TreePlruPolicy::TreePlruPolicy(std::size_t numberOfSets, std::size_t associativity) :
+    ReplacementPolicy(numberOfSets, associativity),
+    treeBits(numberOfSets * associativity, false)
+{
+    if ((associativity & (associativity - 1)) != 0)
+        SC_REPORT_FATAL("TreePlruPolicy", "Associativity must be a power of two!");
+}
+
+void TreePlruPolicy::touch(std::size_t set, std::size_t way)
+{
+    // The nodes of a set are stored as a heap starting at index 1, the leaves are the ways.
+    std::size_t offset = set * associativity;
+    std::size_t node = associativity + way;
+
+    while (node > 1)
+    {
+        bool isRightChild = (node & 1U) != 0;
+        node /= 2;
+        treeBits[offset + node] = !isRightChild;
+    }
+}
+
+void TreePlruPolicy::insert(std::size_t set, std::size_t way)
+{
+    touch(set, way);
+}
+
+std::size_t TreePlruPolicy::getVictim(std::size_t set, const std::vector<bool>& candidates)
+{
+    auto hasCandidate = [&candidates](std::size_t firstWay, std::size_t numberOfWays)
+    {
+        for (std::size_t way = firstWay; way < firstWay + numberOfWays; way++)
+        {
+            if (candidates[way])
+                return true;
+        }
+        return false;
+    };
+
+    if (!hasCandidate(0, associativity))
+        return associativity;
+
+    // Follow the tree bits, but never descend into a subtree without candidates.
+    std::size_t offset = set * associativity;
+    std::size_t node = 1;
+    std::size_t firstWay = 0;
+    std::size_t numberOfWays = associativity;
+
+    while (numberOfWays > 1)
+    {
+        numberOfWays /= 2;
+        bool goRight = treeBits[offset + node];
+
+        if (!hasCandidate(goRight ? firstWay + numberOfWays : firstWay, numberOfWays))
+            goRight = !goRight;
+
+        node = node * 2 + (goRight ? 1 : 0);
+        if (goRight)
+            firstWay += numberOfWays;
+    }
+
+    return firstWay;
+}
+
+SrripPolicy::SrripPolicy(std::size_t numberOfSets, std::size_t associativity) :
+    ReplacementPolicy(numberOfSets, associativity),
+    rrpv(numberOfSets * associativity, MAX_RRPV)
+{
+}
+
+void SrripPolicy::touch(std::size_t set, std::size_t way)
+{
+    rrpv[set * associativity + way] = 0;
+}
+
+void SrripPolicy::insert(std::size_t set, std::size_t way)
+{
+    // New lines are predicted to be re-referenced in the long interval
+    rrpv[set * associativity + way] = MAX_RRPV - 1;
+}
+
+std::size_t SrripPolicy::getVictim(std::size_t set, const std::vector<bool>& candidates)
+{
+    std::uint8_t* setRrpv = rrpv.data() + set * associativity;
+
+    std::size_t victim = associativity;
+    for (std::size_t way = 0; way < associativity; way++)
+    {
+        if (candidates[way] && (victim == associativity || setRrpv[way] > setRrpv[victim]))
+            victim = way;
+    }
+
+    if (victim == associativity)
+        return victim;
+
+    // Aging all lines until the victim reaches the distant interval is equivalent to the
+    // repeated search of the original algorithm
+    std::uint8_t aging = MAX_RRPV - setRrpv[victim];
+    for (std::size_t way = 0; way < associativity; way++)
+        setRrpv[way] = std::min<std::uint8_t>(setRrpv[way] + aging, MAX_RRPV);
+
+    return victim;
+}
+
+RandomPolicy::RandomPolicy(std::size_t numberOfSets, std::size_t associativity) :
+    ReplacementPolicy(numberOfSets, associativity)
+{
+}
+
+void RandomPolicy::touch(std::size_t /*set*/, std::size_t /*way*/) {}
+
+void RandomPolicy::insert(std::size_t /*set*/, std::size_t /*way*/) {}
+
+std::size_t RandomPolicy::getVictim(std::size_t /*set*/, const std::vector<bool>& candidates)
+{
+    std::size_t numberOfCandidates = 0;
+    for (std::size_t way = 0; way < associativity; way++)
+        numberOfCandidates += candidates[way] ? 1 : 0;
+
+    if (numberOfCandidates == 0)
+        return associativity;
+
+    std::size_t candidate = randomGenerator.uniformInt(0, numberOfCandidates - 1);
+
+    for (std::size_t way = 0; way < associativity; way++)
+    {
+        if (candidates[way])
+        {
+            if (candidate == 0)
+                return way;
+            candidate--;
+        }
+    }
+
+    return associativity;
+}
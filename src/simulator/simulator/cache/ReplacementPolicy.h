@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "simulator/generator/SplitMix64.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Decides which line of a set is replaced. The cache notifies the policy about accesses and
+/// allocations and asks for a victim among the lines that can currently be evicted.
+class ReplacementPolicy
+{
+public:
+    virtual ~ReplacementPolicy() = default;
+
+    /// A line was accessed by a read or a write.
+    virtual void touch(std::size_t set, std::size_t way) = 0;
+
+    /// A line was allocated for a new tag.
+    virtual void insert(std::size_t set, std::size_t way) = 0;
+
+    /// Returns the victim among the ways whose candidate flag is set or associativity if there
+    /// is no candidate.
+    virtual std::size_t getVictim(std::size_t set, const std::vector<bool>& candidates) = 0;
+
+protected:
+    ReplacementPolicy(std::size_t numberOfSets, std::size_t associativity);
+
+    const std::size_t numberOfSets;
+    const std::size_t associativity;
+};
+
+/// Exact LRU, each line stores its position in the recency order of its set in one byte.
+class LruPolicy final : public ReplacementPolicy
+{
+public:
+    LruPolicy(std::size_t numberOfSets, std::size_t associativity);
+
+    void touch(std::size_t set, std::size_t way) override;
+    void insert(std::size_t set, std::size_t way) override;
+    std::size_t getVictim(std::size_t set, const std::vector<bool>& candidates) override;
+
+private:
+    // 0 is the most recently used line.
+    std::vector<std::uint8_t> recency;
+};
+
+/// Tree pseudo-LRU with associativity - 1 bits per set, requires a power of two associativity.
+class TreePlruPolicy final : public ReplacementPolicy
+{
+public:
+    TreePlruPolicy(std::size_t numberOfSets, std::size_t associativity);
+
+    void touch(std::size_t set, std::size_t way) override;
+    void insert(std::size_t set, std::size_t way) override;
+    std::size_t getVictim(std::size_t set, const std::vector<bool>& candidates) override;
+
+private:
+    // Each bit points towards the less recently used half of its subtree, 0 is the left half.
+    std::vector<bool> treeBits;
+};
+
+/// Static re-reference interval prediction (SRRIP-HP) with 2 bit prediction values.
+class SrripPolicy final : public ReplacementPolicy
+{
+public:
+    SrripPolicy(std::size_t numberOfSets, std::size_t associativity);
+
+    void touch(std::size_t set, std::size_t way) override;
+    void insert(std::size_t set, std::size_t way) override;
+    std::size_t getVictim(std::size_t set, const std::vector<bool>& candidates) override;
+
+private:
+    static constexpr std::uint8_t MAX_RRPV = 3;
+
+    std::vector<std::uint8_t> rrpv;
+};
+
+/// Uniformly random victim with a fixed seed to keep simulations reproducible.
+class RandomPolicy final : public ReplacementPolicy
+{
+public:
+    RandomPolicy(std::size_t numberOfSets, std::size_t associativity);
+
+    void touch(std::size_t set, std::size_t way) override;
+    void insert(std::size_t set, std::size_t way) override;
+    std::size_t getVictim(std::size_t set, const std::vector<bool>& candidates) override;
+
+private:
+    SplitMix64 randomGenerator;
+};
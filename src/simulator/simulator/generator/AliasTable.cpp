@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "AliasTable.h"
+#include "SplitMix64.h"
+
+#include <numeric>
+
+AliasTable::AliasTable(std::vector<double> const& weights) :
+    probability(weights.size(), 1.0),
+    alias(weights.size())
+{
+    std::size_t n = weights.size();
+    double sum = std::accumulate(weights.cbegin(), weights.cend(), 0.0);
+
+    std::vector<double> scaled(n);
+    std::vector<std::size_t> small;
+    std::vector<std::size_t> large;
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        alias[i] = i;
+        scaled[i] = sum > 0.0 ? weights[i] * static_cast<double>(n) / sum : 1.0;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        std::size_t less = small.back();
+        small.pop_back();
+        std::size_t more = large.back();
+
+        probability[less] = scaled[less];
+        alias[less] = more;
+
+        scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+        if (scaled[more] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+
+    // Remaining entries are only left over due to rounding errors and are always taken
+    for (std::size_t i : small)
+        probability[i] = 1.0;
+}
+
+std::size_t AliasTable::sample(uint64_t random) const
+{
+    // The upper bits select the column, the lower 32 bits decide between column and alias
+    std::size_t column = SplitMix64::toInt(random, 0, probability.size() - 1);
+    double coin = static_cast<double>(random & 0xffffffff) * 0x1.0p-32;
+    return coin < probability[column] ? column : alias[column];
+}
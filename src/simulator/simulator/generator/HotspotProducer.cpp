@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "HotspotProducer.h"
+#include "definitions.h"
+
+HotspotProducer::HotspotProducer(uint64_t numRequests,
+                                 std::optional<uint64_t> seed,
+                                 double rwRatio,
+                                 double hotspotProbability,
+                                 double hotspotSize,
+                                 std::optional<uint64_t> minAddress,
+                                 std::optional<uint64_t> maxAddress,
+                                 uint64_t memorySize,
+                                 unsigned int dataLength,
+                                 unsigned int dataAlignment) :
+    numberOfRequests(numRequests),
+    seed(seed.value_or(DEFAULT_SEED)),
+    rwRatio(rwRatio),
+    hotspotProbability(hotspotProbability),
+    dataLength(dataLength),
+    dataAlignment(dataAlignment),
+    randomGenerator(this->seed)
+{
+    if (minAddress > memorySize - 1)
+        SC_REPORT_FATAL("TrafficGenerator", "minAddress is out of range.");
+
+    if (maxAddress > memorySize - 1)
+        SC_REPORT_FATAL("TrafficGenerator", "maxAddress is out of range.");
+
+    if (maxAddress < minAddress)
+        SC_REPORT_FATAL("TrafficGenerator", "maxAddress is smaller than minAddress.");
+
+    if (rwRatio < 0 || rwRatio > 1)
+        SC_REPORT_FATAL("TraceSetup", "Read/Write ratio is not a number between 0 and 1.");
+
+    if (hotspotProbability < 0 || hotspotProbability > 1)
+        SC_REPORT_FATAL("TrafficGenerator", "hotspotProbability is not a number between 0 and 1.");
+
+    if (hotspotSize <= 0 || hotspotSize >= 1)
+        SC_REPORT_FATAL("TrafficGenerator", "hotspotSize is not a number between 0 and 1.");
+
+    // The hotspot is located at the beginning of the address range, all other accesses are
+    // distributed uniformly over the rest of the address range.
+    uint64_t lowAddress = minAddress.value_or(DEFAULT_MIN_ADDRESS);
+    uint64_t highAddress = maxAddress.value_or(memorySize - dataLength);
+    auto hotspotLength =
+        static_cast<uint64_t>(hotspotSize * static_cast<double>(highAddress - lowAddress + 1));
+
+    if (hotspotLength == 0 || lowAddress + hotspotLength > highAddress)
+        SC_REPORT_FATAL("TrafficGenerator", "hotspotSize does not fit into the address range.");
+
+    hotAddressMin = lowAddress;
+    hotAddressMax = lowAddress + hotspotLength - 1;
+    coldAddressMin = lowAddress + hotspotLength;
+    coldAddressMax = highAddress;
+}
+
+Request HotspotProducer::nextRequest()
+{
+    Request request;
+    request.address = randomGenerator.uniformReal() < hotspotProbability
+                          ? randomGenerator.uniformInt(hotAddressMin, hotAddressMax)
+                          : randomGenerator.uniformInt(coldAddressMin, coldAddressMax);
+
+    // Align address
+    request.address = request.address - (request.address % dataAlignment);
+
+    request.command = randomGenerator.uniformReal() < rwRatio ? Request::Command::Read
+                                                                       : Request::Command::Write;
+    request.length = dataLength;
+    request.delay = sc_core::SC_ZERO_TIME;
+
+    return request;
+}
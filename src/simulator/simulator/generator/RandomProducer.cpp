@@ -49,9 +49,9 @@ RandomProducer::RandomProducer(uint64_t numRequests,
     rwRatio(rwRatio),
     dataLength(dataLength),
     dataAlignment(dataAlignment),
-    randomGenerator(this->seed),
-    randomAddressDistribution(minAddress.value_or(DEFAULT_MIN_ADDRESS),
-                              maxAddress.value_or((memorySize)-dataLength))
+    minAddress(minAddress.value_or(DEFAULT_MIN_ADDRESS)),
+    maxAddress(maxAddress.value_or((memorySize)-dataLength)),
+    randomGenerator(this->seed)
 {
     if (minAddress > memorySize - 1)
         SC_REPORT_FATAL("TrafficGenerator", "minAddress is out of range.");
@@ -69,12 +69,12 @@ RandomProducer::RandomProducer(uint64_t numRequests,
 Request RandomProducer::nextRequest()
 {
     Request request;
-    request.address = randomAddressDistribution(randomGenerator);
+    request.address = randomGenerator.uniformInt(minAddress, maxAddress);
 
     // Align address
     request.address = request.address - (request.address % dataAlignment);
 
-    request.command = readWriteDistribution(randomGenerator) < rwRatio ? Request::Command::Read
+    request.command = randomGenerator.uniformReal() < rwRatio ? Request::Command::Read
                                                                        : Request::Command::Write;
     request.length = dataLength;
     request.delay = sc_core::SC_ZERO_TIME;
@@ -35,10 +35,10 @@
 
 #pragma once
 
+#include "SplitMix64.h"
 #include "simulator/request/RequestProducer.h"
 
 #include <optional>
-#include <random>
 
 class RandomProducer : public RequestProducer
 {
@@ -55,14 +55,15 @@ public:
     Request nextRequest() override;
 
     uint64_t totalRequests() override { return numberOfRequests; }
+    void reset() override { randomGenerator.seek(0); }
 
     const uint64_t numberOfRequests;
     const uint64_t seed;
     const double rwRatio;
     const unsigned int dataLength;
     const unsigned int dataAlignment;
+    const uint64_t minAddress;
+    const uint64_t maxAddress;
 
-    std::default_random_engine randomGenerator;
-    std::uniform_real_distribution<double> readWriteDistribution{0.0, 1.0};
-    std::uniform_int_distribution<uint64_t> randomAddressDistribution;
+    SplitMix64 randomGenerator;
 };
@@ -70,7 +70,7 @@ Request SequentialProducer::nextRequest()
 {
     Request request;
     request.address = generatedRequests * addressIncrement % (maxAddress - minAddress) + minAddress;
-    request.command = readWriteDistribution(randomGenerator) < rwRatio ? Request::Command::Read
+    request.command = randomGenerator.uniformReal() < rwRatio ? Request::Command::Read
                                                                        : Request::Command::Write;
     request.length = dataLength;
     request.delay = sc_core::SC_ZERO_TIME;
@@ -35,10 +35,10 @@
 
 #pragma once
 
+#include "SplitMix64.h"
 #include "simulator/request/RequestProducer.h"
 
 #include <optional>
-#include <random>
 
 class SequentialProducer : public RequestProducer
 {
@@ -55,7 +55,11 @@ public:
     Request nextRequest() override;
 
     uint64_t totalRequests() override { return numberOfRequests; }
-    void reset() override { generatedRequests = 0; }
+    void reset() override
+    {
+        generatedRequests = 0;
+        randomGenerator.seek(0);
+    }
 
     const uint64_t numberOfRequests;
     const uint64_t addressIncrement;
@@ -65,8 +69,7 @@ public:
     const double rwRatio;
     const unsigned int dataLength;
 
-    std::default_random_engine randomGenerator;
-    std::uniform_real_distribution<double> readWriteDistribution{0.0, 1.0};
+    SplitMix64 randomGenerator;
 
     uint64_t generatedRequests = 0;
 };
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+// Counter-based random number generator. The n-th number of a sequence is obtained by applying
+// the SplitMix64 finalizer to seed + n * gamma, so it only depends on the seed and its position.
+// This makes it possible to jump to any position of the sequence in constant time.
+class SplitMix64
+{
+public:
+    using result_type = uint64_t;
+
+    explicit SplitMix64(uint64_t seed = 0) : seed(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() { return at(counter++); }
+
+    // Returns the number at the given position without advancing the generator
+    result_type at(uint64_t position) const
+    {
+        uint64_t z = seed + (position + 1) * GAMMA;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    void discard(uint64_t count) { counter += count; }
+    void seek(uint64_t position) { counter = position; }
+    uint64_t position() const { return counter; }
+
+    // Uniformly distributed number in [0, 1) with 53 bits of precision
+    static double toReal(result_type value) { return static_cast<double>(value >> 11) * 0x1.0p-53; }
+    double uniformReal() { return toReal((*this)()); }
+
+    // Uniformly distributed number in [min, max], mapped with a multiply-shift instead of a
+    // rejection loop so that every call consumes exactly one number of the sequence
+    static uint64_t toInt(result_type value, uint64_t min, uint64_t max)
+    {
+        uint64_t range = max - min + 1;
+        if (range == 0)
+            return value;
+
+#ifdef __SIZEOF_INT128__
+        __extension__ using uint128_t = unsigned __int128;
+        return min + static_cast<uint64_t>((static_cast<uint128_t>(value) * range) >> 64);
+#else
+        auto offset = static_cast<uint64_t>(toReal(value) * static_cast<double>(range));
+        return min + (offset < range ? offset : range - 1);
+#endif
+    }
+    uint64_t uniformInt(uint64_t min, uint64_t max) { return toInt((*this)(), min, max); }
+
+private:
+    static constexpr uint64_t GAMMA = 0x9e3779b97f4a7c15;
+
+    uint64_t seed;
+    uint64_t counter = 0;
+};
@@ -34,15 +34,112 @@
  */
 
 #include "TrafficGenerator.h"
+#include "BankConflictProducer.h"
+#include "HotspotProducer.h"
+#include "StridedProducer.h"
+#include "ZipfProducer.h"
+#include "definitions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+
+template <typename ActiveState>
+static std::unique_ptr<RequestProducer>
+createProducer(ActiveState const& state,
+               std::optional<uint64_t> seed,
+               uint64_t memorySize,
+               unsigned int dataLength,
+               unsigned int dataAlignment,
+               DRAMSys::AddressDecoder const& addressDecoder)
+{
+    using DRAMSys::Config::AddressDistribution;
+
+    switch (state.addressDistribution)
+    {
+    case AddressDistribution::Random:
+        return std::make_unique<RandomProducer>(state.numRequests,
+                                                seed,
+                                                state.rwRatio,
+                                                state.minAddress,
+                                                state.maxAddress,
+                                                memorySize,
+                                                dataLength,
+                                                dataAlignment);
+    case AddressDistribution::Strided:
+        return std::make_unique<StridedProducer>(state.numRequests,
+                                                 seed,
+                                                 state.rwRatio,
+                                                 state.numStreams,
+                                                 state.addressIncrement,
+                                                 state.minAddress,
+                                                 state.maxAddress,
+                                                 memorySize,
+                                                 dataLength);
+    case AddressDistribution::Zipf:
+        return std::make_unique<ZipfProducer>(state.numRequests,
+                                              seed,
+                                              state.rwRatio,
+                                              state.zipfExponent,
+                                              state.blockSize,
+                                              state.minAddress,
+                                              state.maxAddress,
+                                              memorySize,
+                                              dataLength,
+                                              dataAlignment);
+    case AddressDistribution::Hotspot:
+        if (!state.hotspotProbability.has_value() || !state.hotspotSize.has_value())
+            SC_REPORT_FATAL("TrafficGenerator",
+                            "Hotspot distribution requires hotspotProbability and hotspotSize.");
+
+        return std::make_unique<HotspotProducer>(state.numRequests,
+                                                 seed,
+                                                 state.rwRatio,
+                                                 state.hotspotProbability.value_or(0.0),
+                                                 state.hotspotSize.value_or(0.0),
+                                                 state.minAddress,
+                                                 state.maxAddress,
+                                                 memorySize,
+                                                 dataLength,
+                                                 dataAlignment);
+    case AddressDistribution::BankConflict:
+        return std::make_unique<BankConflictProducer>(state.numRequests,
+                                                      seed,
+                                                      state.rwRatio,
+                                                      state.minAddress,
+                                                      state.maxAddress,
+                                                      memorySize,
+                                                      dataLength,
+                                                      dataAlignment,
+                                                      addressDecoder);
+    default:
+        return std::make_unique<SequentialProducer>(state.numRequests,
+                                                    seed,
+                                                    state.rwRatio,
+                                                    state.addressIncrement,
+                                                    state.minAddress,
+                                                    state.maxAddress,
+                                                    memorySize,
+                                                    dataLength);
+    }
+}
+
+template <typename Config> static bool isRateControlled(Config const& config)
+{
+    return config.targetBandwidth.has_value() || config.targetRequestRate.has_value();
+}
 
 TrafficGenerator::TrafficGenerator(DRAMSys::Config::TrafficGeneratorStateMachine const& config,
                                    MemoryManager& memoryManager,
                                    uint64_t memorySize,
                                    unsigned int defaultDataLength,
+                                   DRAMSys::AddressDecoder const& addressDecoder,
                                    std::function<void()> transactionFinished,
                                    std::function<void()> terminateInitiator) :
-    stateTransistions(config.transitions),
+    name(config.name),
     generatorPeriod(sc_core::sc_time(1.0 / static_cast<double>(config.clkMhz), sc_core::SC_US)),
+    randomGenerator(config.seed.value_or(DEFAULT_SEED)),
     issuer(
         config.name.c_str(),
         memoryManager,
@@ -51,7 +148,16 @@ TrafficGenerator::TrafficGenerator(DRAMSys::Config::TrafficGeneratorStateMachine
         config.maxPendingWriteRequests,
         [this] { return nextRequest(); },
         std::move(transactionFinished),
-        std::move(terminateInitiator))
+        [this, terminateInitiator = std::move(terminateInitiator)]
+        {
+            reportLoadCurve();
+            terminateInitiator();
+        },
+        isRateControlled(config)
+            ? RequestIssuer::LatencyCallback([this](sc_core::sc_time sendingTime,
+                                                    sc_core::sc_time latency)
+                                             { recordLatency(sendingTime, latency); })
+            : RequestIssuer::LatencyCallback())
 {
     unsigned int dataLength = config.dataLength.value_or(defaultDataLength);
     unsigned int dataAlignment = config.dataAlignment.value_or(dataLength);
@@ -59,7 +165,7 @@ TrafficGenerator::TrafficGenerator(DRAMSys::Config::TrafficGeneratorStateMachine
     for (auto const& state : config.states)
     {
         std::visit(
-            [=, &config](auto&& arg)
+            [=, &config, &addressDecoder](auto&& arg)
             {
                 using DRAMSys::Config::TrafficGeneratorActiveState;
                 using DRAMSys::Config::TrafficGeneratorIdleState;
@@ -67,34 +173,14 @@ TrafficGenerator::TrafficGenerator(DRAMSys::Config::TrafficGeneratorStateMachine
                 if constexpr (std::is_same_v<T, TrafficGeneratorActiveState>)
                 {
                     auto const& activeState = arg;
-                    if (activeState.addressDistribution ==
-                        DRAMSys::Config::AddressDistribution::Random)
-                    {
-                        auto producer = std::make_unique<RandomProducer>(activeState.numRequests,
-                                                                         config.seed,
-                                                                         activeState.rwRatio,
-                                                                         activeState.minAddress,
-                                                                         activeState.maxAddress,
-                                                                         memorySize,
-                                                                         dataLength,
-                                                                         dataAlignment);
-
-                        producers.emplace(activeState.id, std::move(producer));
-                    }
-                    else
-                    {
-                        auto producer =
-                            std::make_unique<SequentialProducer>(activeState.numRequests,
-                                                                 config.seed,
-                                                                 activeState.rwRatio,
-                                                                 activeState.addressIncrement,
-                                                                 activeState.minAddress,
-                                                                 activeState.maxAddress,
-                                                                 memorySize,
-                                                                 dataLength);
-
-                        producers.emplace(activeState.id, std::move(producer));
-                    }
+                    auto producer = createProducer(activeState,
+                                                   config.seed,
+                                                   memorySize,
+                                                   dataLength,
+                                                   dataAlignment,
+                                                   addressDecoder);
+
+                    producers.emplace(activeState.id, std::move(producer));
                 }
                 else if constexpr (std::is_same_v<T, TrafficGeneratorIdleState>)
                 {
@@ -104,14 +190,34 @@ TrafficGenerator::TrafficGenerator(DRAMSys::Config::TrafficGeneratorStateMachine
             },
             state);
     }
+
+    // Group the transitions by their source state and precompute the sampling tables
+    std::unordered_map<unsigned int, std::vector<double>> transitionProbabilities;
+    std::unordered_map<unsigned int, std::vector<unsigned int>> transitionTargets;
+    for (auto const& transition : config.transitions)
+    {
+        transitionProbabilities[transition.from].push_back(transition.probability);
+        transitionTargets[transition.from].push_back(transition.to);
+    }
+
+    for (auto& [from, targets] : transitionTargets)
+    {
+        AliasTable distribution(transitionProbabilities.at(from));
+        transitionTables.emplace(from,
+                                 TransitionTable{std::move(targets), std::move(distribution)});
+    }
+
+    setupRateControl(config, dataLength);
 }
 
 TrafficGenerator::TrafficGenerator(DRAMSys::Config::TrafficGenerator const& config,
                                    MemoryManager& memoryManager,
                                    uint64_t memorySize,
                                    unsigned int defaultDataLength,
+                                   DRAMSys::AddressDecoder const& addressDecoder,
                                    std::function<void()> transactionFinished,
                                    std::function<void()> terminateInitiator) :
+    name(config.name),
     generatorPeriod(sc_core::sc_time(1.0 / static_cast<double>(config.clkMhz), sc_core::SC_US)),
     issuer(
         config.name.c_str(),
@@ -121,35 +227,76 @@ TrafficGenerator::TrafficGenerator(DRAMSys::Config::TrafficGenerator const& conf
         config.maxPendingWriteRequests,
         [this] { return nextRequest(); },
         std::move(transactionFinished),
-        std::move(terminateInitiator))
+        [this, terminateInitiator = std::move(terminateInitiator)]
+        {
+            reportLoadCurve();
+            terminateInitiator();
+        },
+        isRateControlled(config)
+            ? RequestIssuer::LatencyCallback([this](sc_core::sc_time sendingTime,
+                                                    sc_core::sc_time latency)
+                                             { recordLatency(sendingTime, latency); })
+            : RequestIssuer::LatencyCallback())
 {
     unsigned int dataLength = config.dataLength.value_or(defaultDataLength);
     unsigned int dataAlignment = config.dataAlignment.value_or(dataLength);
 
-    if (config.addressDistribution == DRAMSys::Config::AddressDistribution::Random)
+    auto producer = createProducer(
+        config, config.seed, memorySize, dataLength, dataAlignment, addressDecoder);
+    producers.emplace(0, std::move(producer));
+
+    setupRateControl(config, dataLength);
+}
+
+template <typename Config>
+void TrafficGenerator::setupRateControl(Config const& config, unsigned int dataLength)
+{
+    if (config.targetBandwidth.has_value() && config.targetRequestRate.has_value())
+        SC_REPORT_FATAL("TrafficGenerator",
+                        "Only one of targetBandwidth and targetRequestRate can be specified.");
+
+    if (!isRateControlled(config))
     {
-        auto producer = std::make_unique<RandomProducer>(config.numRequests,
-                                                         config.seed,
-                                                         config.rwRatio,
-                                                         config.minAddress,
-                                                         config.maxAddress,
-                                                         memorySize,
-                                                         dataLength,
-                                                         dataAlignment);
-        producers.emplace(0, std::move(producer));
+        if (config.sweepSteps.has_value())
+            SC_REPORT_FATAL("TrafficGenerator",
+                            "sweepSteps requires targetBandwidth or targetRequestRate.");
+        return;
     }
-    else
+
+    double target = config.targetBandwidth.value_or(config.targetRequestRate.value_or(0.0));
+    if (target <= 0.0)
+        SC_REPORT_FATAL("TrafficGenerator", "Target bandwidth or request rate must be positive.");
+
+    unsigned int sweepSteps = config.sweepSteps.value_or(1);
+    if (sweepSteps == 0)
+        SC_REPORT_FATAL("TrafficGenerator", "sweepSteps must be at least 1.");
+
+    arrivalProcess = config.arrivalProcess.value_or(DRAMSys::Config::ArrivalProcess::Constant);
+    if (arrivalProcess == DRAMSys::Config::ArrivalProcess::Invalid)
+        SC_REPORT_FATAL("TrafficGenerator", "Invalid arrival process.");
+
+    burstSize = config.burstSize.value_or(1);
+    if (burstSize == 0)
+        SC_REPORT_FATAL("TrafficGenerator", "burstSize must be at least 1.");
+
+    bytesPerRequest = dataLength;
+    arrivalGenerator = SplitMix64(~config.seed.value_or(DEFAULT_SEED));
+
+    // Bandwidth in GB/s equals bytes per ns, the request rate is given in million requests per
+    // second
+    sc_core::sc_time meanInterArrivalTime =
+        config.targetBandwidth.has_value()
+            ? sc_core::sc_time(static_cast<double>(dataLength) / target, sc_core::SC_NS)
+            : sc_core::sc_time(1.0 / target, sc_core::SC_US);
+
+    // The load levels of a sweep are evenly spaced up to the target
+    for (unsigned int step = 1; step <= sweepSteps; step++)
     {
-        auto producer = std::make_unique<SequentialProducer>(config.numRequests,
-                                                             config.seed,
-                                                             config.rwRatio,
-                                                             config.addressIncrement,
-                                                             config.minAddress,
-                                                             config.maxAddress,
-                                                             memorySize,
-                                                             dataLength);
-        producers.emplace(0, std::move(producer));
+        double loadFactor = static_cast<double>(step) / static_cast<double>(sweepSteps);
+        loadLevels.push_back(LoadLevel{meanInterArrivalTime / loadFactor});
     }
+
+    loadLevels.front().start = sc_core::SC_ZERO_TIME;
 }
 
 Request TrafficGenerator::nextRequest()
@@ -160,7 +307,7 @@ Request TrafficGenerator::nextRequest()
         // Reset current producer to its initial state
         producers[currentState]->reset();
 
-        auto newState = stateTransition(currentState);
+        auto newState = nextState(currentState);
 
         if (!newState.has_value())
             return Request{Request::Command::Stop};
@@ -169,7 +316,7 @@ Request TrafficGenerator::nextRequest()
         while (idleStateIt != idleStateClks.cend())
         {
             clksToIdle += idleStateIt->second;
-            newState = stateTransition(currentState);
+            newState = nextState(newState.value());
 
             if (!newState.has_value())
                 return Request{Request::Command::Stop};
@@ -186,24 +333,30 @@ Request TrafficGenerator::nextRequest()
 
     Request request = producers[currentState]->nextRequest();
     request.delay += generatorPeriod * static_cast<double>(clksToIdle);
+
+    if (!loadLevels.empty())
+    {
+        nextArrival += generatorPeriod * static_cast<double>(clksToIdle);
+
+        sc_core::sc_time now = sc_core::sc_time_stamp();
+        request.delay = nextArrival > now ? nextArrival - now : sc_core::SC_ZERO_TIME;
+        nextArrival += interArrivalTime();
+    }
+
     return request;
 }
 
 uint64_t TrafficGenerator::totalRequests()
 {
-    // Store current state of random generator
-    std::default_random_engine tempGenerator(randomGenerator);
-
-    // Reset generator to initial state
-    randomGenerator.seed();
-
+    // Replay the state transitions from the start of the random sequence
+    uint64_t transition = 0;
     uint64_t totalRequests = 0;
     unsigned int currentState = 0;
 
     if (producers.find(currentState) != producers.cend())
         totalRequests += producers.at(currentState)->totalRequests();
 
-    while (auto nextState = stateTransition(currentState))
+    while (auto nextState = stateTransition(currentState, randomGenerator.at(transition++)))
     {
         currentState = nextState.value();
 
@@ -211,36 +364,99 @@ uint64_t TrafficGenerator::totalRequests()
             totalRequests += producers.at(currentState)->totalRequests();
     }
 
-    // Restore state of random generator
-    randomGenerator = tempGenerator;
+    // The request sequence is repeated for every load level of a sweep
+    return totalRequests * std::max<uint64_t>(loadLevels.size(), 1);
+}
+
+std::optional<unsigned int> TrafficGenerator::stateTransition(unsigned int from,
+                                                              uint64_t random) const
+{
+    auto tableIt = transitionTables.find(from);
+    if (tableIt == transitionTables.cend())
+        return std::nullopt;
 
-    return totalRequests;
+    auto const& [targets, distribution] = tableIt->second;
+    return targets[distribution.sample(random)];
 }
 
-std::optional<unsigned int> TrafficGenerator::stateTransition(unsigned int from)
+std::optional<unsigned int> TrafficGenerator::nextState(unsigned int from)
 {
-    using Transition = DRAMSys::Config::TrafficGeneratorStateTransition;
+    auto newState = stateTransition(from, randomGenerator());
 
-    std::vector<Transition> relevantTransitions;
-    std::copy_if(stateTransistions.cbegin(),
-                 stateTransistions.cend(),
-                 std::back_inserter(relevantTransitions),
-                 [from](Transition transition) { return transition.from == from; });
+    if (newState.has_value() || currentLevel + 1 >= loadLevels.size())
+        return newState;
 
-    if (relevantTransitions.empty())
-        return std::nullopt;
+    // Replay the same request sequence with the next load level
+    currentLevel++;
+    loadLevels[currentLevel].start = sc_core::sc_time_stamp();
+    nextArrival = sc_core::sc_time_stamp();
+    requestsInBurst = 0;
+    randomGenerator.seek(0);
+    return 0;
+}
 
-    std::vector<double> propabilities;
-    std::for_each(relevantTransitions.cbegin(),
-                  relevantTransitions.cend(),
-                  [&propabilities](Transition transition)
-                  { propabilities.push_back(transition.probability); });
+sc_core::sc_time TrafficGenerator::interArrivalTime()
+{
+    using DRAMSys::Config::ArrivalProcess;
 
-    assert(propabilities.size() == relevantTransitions.size());
+    sc_core::sc_time meanInterArrivalTime = loadLevels[currentLevel].meanInterArrivalTime;
 
-    std::discrete_distribution<std::size_t> stateTransitionDistribution(propabilities.cbegin(),
-                                                                        propabilities.cend());
+    switch (arrivalProcess)
+    {
+    case ArrivalProcess::Poisson:
+        return meanInterArrivalTime * -std::log(1.0 - arrivalGenerator.uniformReal());
+    case ArrivalProcess::Bursty:
+        // Bursts of back-to-back requests arrive as a Poisson process with the same mean rate
+        if (++requestsInBurst < burstSize)
+            return sc_core::SC_ZERO_TIME;
+
+        requestsInBurst = 0;
+        return meanInterArrivalTime * static_cast<double>(burstSize) *
+               -std::log(1.0 - arrivalGenerator.uniformReal());
+    default:
+        return meanInterArrivalTime;
+    }
+}
+
+void TrafficGenerator::recordLatency(sc_core::sc_time sendingTime, sc_core::sc_time latency)
+{
+    // The load levels are ordered by their start time
+    auto levelIt = std::upper_bound(loadLevels.begin(),
+                                    loadLevels.end(),
+                                    sendingTime,
+                                    [](sc_core::sc_time time, LoadLevel const& level)
+                                    { return time < level.start; });
+    LoadLevel& level = *std::prev(levelIt);
+
+    level.transactions++;
+    level.totalLatency += latency;
+    level.maxLatency = std::max(level.maxLatency, latency);
+    level.lastResponse = std::max(level.lastResponse, sendingTime + latency);
+}
 
-    std::size_t index = stateTransitionDistribution(randomGenerator);
-    return relevantTransitions[index].to;
+void TrafficGenerator::reportLoadCurve() const
+{
+    if (loadLevels.empty())
+        return;
+
+    std::cout << "Load curve of " << name << ":" << std::endl;
+    std::cout << "target bandwidth [GB/s],achieved bandwidth [GB/s],average latency [ns],"
+                 "maximum latency [ns]"
+              << std::endl;
+
+    for (auto const& level : loadLevels)
+    {
+        if (level.transactions == 0)
+            continue;
+
+        double bytes = static_cast<double>(level.transactions * bytesPerRequest);
+        double targetBandwidth =
+            static_cast<double>(bytesPerRequest) / level.meanInterArrivalTime.to_seconds() * 1e-9;
+        double achievedBandwidth = bytes / (level.lastResponse - level.start).to_seconds() * 1e-9;
+        double averageLatency = level.totalLatency.to_seconds() * 1e9 /
+                                static_cast<double>(level.transactions);
+
+        std::cout << targetBandwidth << "," << achievedBandwidth << "," << averageLatency << ","
+                  << level.maxLatency.to_seconds() * 1e9 << std::endl;
+    }
 }
@@ -35,13 +35,16 @@
 
 #pragma once
 
+#include "AliasTable.h"
 #include "RandomProducer.h"
 #include "SequentialProducer.h"
+#include "SplitMix64.h"
 #include "simulator/Initiator.h"
 #include "simulator/MemoryManager.h"
 #include "simulator/request/RequestIssuer.h"
 
 #include <DRAMSys/config/DRAMSysConfiguration.h>
+#include <DRAMSys/simulation/AddressDecoder.h>
 
 class TrafficGenerator : public Initiator
 {
@@ -50,6 +53,7 @@ public:
                      MemoryManager& memoryManager,
                      uint64_t memorySize,
                      unsigned int defaultDataLength,
+                     DRAMSys::AddressDecoder const& addressDecoder,
                      std::function<void()> transactionFinished,
                      std::function<void()> terminateInitiator);
 
@@ -57,26 +61,67 @@ public:
                      MemoryManager& memoryManager,
                      uint64_t memorySize,
                      unsigned int defaultDataLength,
+                     DRAMSys::AddressDecoder const& addressDecoder,
                      std::function<void()> transactionFinished,
                      std::function<void()> terminateInitiator);
 
-    void bind(tlm_utils::multi_target_base<>& target) override { issuer.iSocket.bind(target); }
+    void bind(tlm::tlm_base_target_socket_b<>& target) override { issuer.iSocket.bind(target); }
 
     uint64_t totalRequests() override;
     Request nextRequest();
 
-    std::optional<unsigned int> stateTransition(unsigned int from);
+    // Picks the successor of a state based on the given random number
+    std::optional<unsigned int> stateTransition(unsigned int from, uint64_t random) const;
 
 private:
+    template <typename Config> void setupRateControl(Config const& config, unsigned int dataLength);
+    std::optional<unsigned int> nextState(unsigned int from);
+    sc_core::sc_time interArrivalTime();
+    void recordLatency(sc_core::sc_time sendingTime, sc_core::sc_time latency);
+    void reportLoadCurve() const;
+
+    const std::string name;
+
     uint64_t requestsInState = 0;
     unsigned int currentState = 0;
-    const std::vector<DRAMSys::Config::TrafficGeneratorStateTransition> stateTransistions;
+
+    struct TransitionTable
+    {
+        std::vector<unsigned int> targets;
+        AliasTable distribution;
+    };
+    std::unordered_map<unsigned int, TransitionTable> transitionTables;
 
     using IdleClks = uint64_t;
     std::unordered_map<unsigned int, IdleClks> idleStateClks;
     const sc_core::sc_time generatorPeriod;
 
-    std::default_random_engine randomGenerator;
+    // Every state transition consumes exactly one number of this sequence, so it can be replayed
+    // from the beginning without disturbing the running generator
+    SplitMix64 randomGenerator;
+
+    // Closed-loop rate control: every request is issued at the arrival time given by the arrival
+    // process. When the generator falls behind, e.g., due to backpressure, it issues requests back
+    // to back until it has caught up again. In a load sweep, the complete request sequence is
+    // repeated for each load level.
+    struct LoadLevel
+    {
+        sc_core::sc_time meanInterArrivalTime;
+        sc_core::sc_time start = sc_core::sc_max_time();
+        sc_core::sc_time lastResponse = sc_core::SC_ZERO_TIME;
+        sc_core::sc_time totalLatency = sc_core::SC_ZERO_TIME;
+        sc_core::sc_time maxLatency = sc_core::SC_ZERO_TIME;
+        uint64_t transactions = 0;
+    };
+    std::vector<LoadLevel> loadLevels;
+    std::size_t currentLevel = 0;
+
+    DRAMSys::Config::ArrivalProcess arrivalProcess = DRAMSys::Config::ArrivalProcess::Constant;
+    unsigned int burstSize = 1;
+    unsigned int requestsInBurst = 0;
+    unsigned int bytesPerRequest = 0;
+    sc_core::sc_time nextArrival = sc_core::SC_ZERO_TIME;
+    SplitMix64 arrivalGenerator;
 
     std::unordered_map<unsigned int, std::unique_ptr<RequestProducer>> producers;
     RequestIssuer issuer;
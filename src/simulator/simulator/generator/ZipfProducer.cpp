@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ZipfProducer.h"
+#include "definitions.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Generalized harmonic number H(n, theta). Only the first terms are summed up explicitly, the
+// remainder is approximated with the Euler-Maclaurin formula.
+static double zeta(uint64_t n, double theta)
+{
+    constexpr uint64_t EXACT_TERMS = 1 << 20;
+
+    uint64_t k = std::min(n, EXACT_TERMS);
+    double sum = 0.0;
+    for (uint64_t i = 1; i <= k; i++)
+        sum += std::pow(static_cast<double>(i), -theta);
+
+    if (n > k)
+    {
+        auto nd = static_cast<double>(n);
+        auto kd = static_cast<double>(k);
+        sum += (std::pow(nd, 1.0 - theta) - std::pow(kd, 1.0 - theta)) / (1.0 - theta) +
+               (std::pow(nd, -theta) - std::pow(kd, -theta)) / 2.0;
+    }
+
+    return sum;
+}
+
+ZipfProducer::ZipfProducer(uint64_t numRequests,
+                           std::optional<uint64_t> seed,
+                           double rwRatio,
+                           std::optional<double> zipfExponent,
+                           std::optional<uint64_t> blockSize,
+                           std::optional<uint64_t> minAddress,
+                           std::optional<uint64_t> maxAddress,
+                           uint64_t memorySize,
+                           unsigned int dataLength,
+                           unsigned int dataAlignment) :
+    numberOfRequests(numRequests),
+    seed(seed.value_or(DEFAULT_SEED)),
+    rwRatio(rwRatio),
+    dataLength(dataLength),
+    dataAlignment(dataAlignment),
+    minAddress(minAddress.value_or(DEFAULT_MIN_ADDRESS)),
+    blockSize(blockSize.value_or(dataLength)),
+    numberOfBlocks(this->blockSize == 0
+                       ? 0
+                       : (maxAddress.value_or(memorySize - 1) - this->minAddress + 1) /
+                             this->blockSize),
+    zipfExponent(zipfExponent.value_or(DEFAULT_ZIPF_EXPONENT)),
+    blockOffsets(std::max<uint64_t>(this->blockSize / dataAlignment, 1)),
+    randomGenerator(this->seed)
+{
+    if (minAddress > memorySize - 1)
+        SC_REPORT_FATAL("TrafficGenerator", "minAddress is out of range.");
+
+    if (maxAddress > memorySize - 1)
+        SC_REPORT_FATAL("TrafficGenerator", "maxAddress is out of range.");
+
+    if (maxAddress < minAddress)
+        SC_REPORT_FATAL("TrafficGenerator", "maxAddress is smaller than minAddress.");
+
+    if (rwRatio < 0 || rwRatio > 1)
+        SC_REPORT_FATAL("TraceSetup", "Read/Write ratio is not a number between 0 and 1.");
+
+    if (this->zipfExponent <= 0 || this->zipfExponent >= 1)
+        SC_REPORT_FATAL("TrafficGenerator", "zipfExponent is not a number between 0 and 1.");
+
+    if (this->blockSize == 0 || numberOfBlocks == 0)
+        SC_REPORT_FATAL("TrafficGenerator", "blockSize does not fit into the address range.");
+
+    zetaN = zeta(numberOfBlocks, this->zipfExponent);
+    alpha = 1.0 / (1.0 - this->zipfExponent);
+    eta = (1.0 - std::pow(2.0 / static_cast<double>(numberOfBlocks), 1.0 - this->zipfExponent)) /
+          (1.0 - zeta(2, this->zipfExponent) / zetaN);
+}
+
+Request ZipfProducer::nextRequest()
+{
+    // The block with index 0 is the most frequently accessed one.
+    double u = randomGenerator.uniformReal();
+    double uz = u * zetaN;
+
+    uint64_t block = 0;
+    if (uz < 1.0)
+        block = 0;
+    else if (uz < 1.0 + std::pow(0.5, zipfExponent))
+        block = 1;
+    else
+        block = static_cast<uint64_t>(static_cast<double>(numberOfBlocks) *
+                                      std::pow(eta * u - eta + 1.0, alpha));
+
+    block = std::min(block, numberOfBlocks - 1);
+
+    Request request;
+    request.address = minAddress + block * blockSize +
+                      randomGenerator.uniformInt(0, blockOffsets - 1) * dataAlignment;
+    request.command = randomGenerator.uniformReal() < rwRatio ? Request::Command::Read
+                                                                       : Request::Command::Write;
+    request.length = dataLength;
+    request.delay = sc_core::SC_ZERO_TIME;
+
+    return request;
+}
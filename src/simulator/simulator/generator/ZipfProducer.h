@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "SplitMix64.h"
+#include "simulator/request/RequestProducer.h"
+
+#include <optional>
+
+class ZipfProducer : public RequestProducer
+{
+public:
+    ZipfProducer(uint64_t numRequests,
+                 std::optional<uint64_t> seed,
+                 double rwRatio,
+                 std::optional<double> zipfExponent,
+                 std::optional<uint64_t> blockSize,
+                 std::optional<uint64_t> minAddress,
+                 std::optional<uint64_t> maxAddress,
+                 uint64_t memorySize,
+                 unsigned int dataLength,
+                 unsigned int dataAlignment);
+
+    Request nextRequest() override;
+
+    uint64_t totalRequests() override { return numberOfRequests; }
+    void reset() override { randomGenerator.seek(0); }
+
+    const uint64_t numberOfRequests;
+    const uint64_t seed;
+    const double rwRatio;
+    const unsigned int dataLength;
+    const unsigned int dataAlignment;
+    const uint64_t minAddress;
+    const uint64_t blockSize;
+    const uint64_t numberOfBlocks;
+    const double zipfExponent;
+
+    // Constants of the Zipf generator by Gray et al., "Quickly Generating Billion-Record
+    // Synthetic Databases"
+    double zetaN;
+    double alpha;
+    double eta;
+
+    // Number of aligned positions within a block
+    uint64_t blockOffsets;
+
+    SplitMix64 randomGenerator;
+};
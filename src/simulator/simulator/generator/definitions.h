@@ -39,3 +39,5 @@
 
 inline constexpr uint64_t DEFAULT_SEED = 0;
 inline constexpr uint64_t DEFAULT_MIN_ADDRESS = 0;
+inline constexpr double DEFAULT_ZIPF_EXPONENT = 0.99;
+inline constexpr unsigned int DEFAULT_NUM_STREAMS = 1;
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *    Janik Schlemminger
+ *    Robert Gernhardt
+ *    Matthias Jung
+ *    Éder F. Zulian
+ *    Felipe S. Prado
+ *    Derek Christ
+ */
+
+#include "StlParser.h"
+
+#include <sstream>
+#include <systemc>
+
+static int hexDigitValue(char digit)
+{
+    if (digit >= '0' && digit <= '9')
+        return digit - '0';
+    if (digit >= 'a' && digit <= 'f')
+        return digit - 'a' + 10;
+    if (digit >= 'A' && digit <= 'F')
+        return digit - 'A' + 10;
+    return -1;
+}
+
+StlParser::StlParser(std::string_view tracePath,
+                     unsigned int defaultDataLength,
+                     bool storageEnabled) :
+    defaultDataLength(defaultDataLength),
+    storageEnabled(storageEnabled),
+    traceFile(tracePath.data())
+{
+    if (!traceFile.is_open())
+        SC_REPORT_FATAL("StlPlayer",
+                        (std::string("Could not open trace ") + tracePath.data()).c_str());
+
+    std::string line;
+    while (std::getline(traceFile, line))
+    {
+        if (line.size() > 1 && line[0] != '#')
+            lineCount++;
+    }
+    if (lineCount == 0)
+        SC_REPORT_FATAL("StlPlayer", (std::string("Empty trace ") + tracePath.data()).c_str());
+
+    rewind();
+}
+
+void StlParser::rewind()
+{
+    traceFile.clear();
+    traceFile.seekg(0);
+    currentLine = 0;
+}
+
+void StlParser::parse(TraceBlock& block, std::size_t maxLines)
+{
+    std::size_t parsedLines = 0;
+    block.clear();
+
+    while (traceFile && !traceFile.eof() && parsedLines < maxLines)
+    {
+        // Get a new line from the input file.
+        std::string line;
+        std::getline(traceFile, line);
+        currentLine++;
+
+        // If the line is empty (\n or \r\n) or starts with '#' (comment) the transaction is
+        // ignored.
+        if (line.size() <= 1 || line.at(0) == '#')
+            continue;
+
+        parsedLines++;
+        block.entries.emplace_back();
+        TraceEntry& content = block.entries.back();
+
+        // Trace files MUST provide timestamp, command and address for every
+        // transaction. The data information depends on the storage mode
+        // configuration.
+        std::string element;
+        std::istringstream iss;
+
+        iss.str(line);
+
+        try
+        {
+            // Get the timestamp for the transaction.
+            iss >> element;
+            if (element.empty())
+                SC_REPORT_FATAL(
+                    "StlPlayer",
+                    ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
+
+            content.cycle = std::stoull(element);
+
+            // Get the optional burst length and command
+            iss >> element;
+            if (element.empty())
+                SC_REPORT_FATAL(
+                    "StlPlayer",
+                    ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
+
+            if (element.at(0) == '(')
+            {
+                element.erase(0, 1);
+                content.length = std::stoul(element);
+                iss >> element;
+                if (element.empty())
+                    SC_REPORT_FATAL(
+                        "StlPlayer",
+                        ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
+            }
+            else
+                content.length = defaultDataLength;
+
+            if (element == "read")
+                content.command = Request::Command::Read;
+            else if (element == "write")
+                content.command = Request::Command::Write;
+            else
+                SC_REPORT_FATAL(
+                    "StlPlayer",
+                    ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
+
+            // Get the address.
+            iss >> element;
+            if (element.empty())
+                SC_REPORT_FATAL(
+                    "StlPlayer",
+                    ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
+            content.address = std::stoull(element, nullptr, 16);
+
+            // Get the data if necessary.
+            if (storageEnabled && content.command == Request::Command::Write)
+            {
+                // The input trace file must provide the data to be stored into the memory.
+                iss >> element;
+
+                // Check if data length in the trace file is correct.
+                // We need two characters to represent 1 byte in hexadecimal. Offset for 0x
+                // prefix.
+                if (element.length() != (content.length * 2 + 2))
+                    SC_REPORT_FATAL(
+                        "StlPlayer",
+                        ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
+
+                // Set data
+                content.dataOffset = block.data.size();
+                block.data.resize(block.data.size() + content.length);
+                unsigned char* data = block.data.data() + content.dataOffset;
+
+                for (unsigned i = 0; i < content.length; i++)
+                {
+                    int high = hexDigitValue(element[i * 2 + 2]);
+                    int low = hexDigitValue(element[i * 2 + 3]);
+                    if (high < 0 || low < 0)
+                        SC_REPORT_FATAL("StlPlayer",
+                                        ("Malformed trace file line " +
+                                         std::to_string(currentLine) + ".")
+                                            .c_str());
+
+                    data[i] = static_cast<unsigned char>((high << 4) | low);
+                }
+            }
+        }
+        catch (...)
+        {
+            SC_REPORT_FATAL(
+                "StlPlayer",
+                ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
+        }
+    }
+}
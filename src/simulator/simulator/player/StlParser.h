@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *    Janik Schlemminger
+ *    Robert Gernhardt
+ *    Matthias Jung
+ *    Éder F. Zulian
+ *    Felipe S. Prado
+ *    Derek Christ
+ */
+
+#pragma once
+
+#include "simulator/request/Request.h"
+
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+struct TraceEntry
+{
+    uint64_t cycle{};
+    uint64_t address{};
+    uint64_t dataOffset{};
+    unsigned int length{};
+    Request::Command command{};
+};
+
+// A contiguous block of parsed trace lines. The write data of all entries is stored in one
+// shared buffer and referenced by the dataOffset of each entry.
+struct TraceBlock
+{
+    std::vector<TraceEntry> entries;
+    std::vector<unsigned char> data;
+
+    void clear()
+    {
+        entries.clear();
+        data.clear();
+    }
+};
+
+class StlParser
+{
+public:
+    StlParser(std::string_view tracePath, unsigned int defaultDataLength, bool storageEnabled);
+
+    uint64_t numberOfLines() const { return lineCount; }
+
+    void rewind();
+    void parse(TraceBlock& block, std::size_t maxLines);
+
+private:
+    const unsigned int defaultDataLength;
+    const bool storageEnabled;
+
+    std::ifstream traceFile;
+    uint64_t currentLine = 0;
+    uint64_t lineCount = 0;
+};
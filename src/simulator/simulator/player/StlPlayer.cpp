@@ -39,199 +39,182 @@
  */
 
 #include "StlPlayer.h"
-
-#include <sstream>
+#include "TraceCache.h"
 
 StlPlayer::StlPlayer(std::string_view tracePath,
                      unsigned int clkMhz,
                      unsigned int defaultDataLength,
                      TraceType traceType,
-                     bool storageEnabled) :
+                     bool storageEnabled,
+                     uint64_t loops,
+                     double timeScale,
+                     uint64_t addressOffset,
+                     uint64_t addressMask,
+                     const DRAMSys::AddressDecoder* addressDecoder,
+                     uint64_t dramAddressOffset,
+                     bool sharedTrace) :
     traceType(traceType),
     storageEnabled(storageEnabled),
     playerPeriod(sc_core::sc_time(1.0 / static_cast<double>(clkMhz), sc_core::SC_US)),
-    defaultDataLength(defaultDataLength),
-    traceFile(tracePath.data()),
-    lineBuffers(
-        {std::make_shared<std::vector<Request>>(), std::make_shared<std::vector<Request>>()}),
-    parseBuffer(lineBuffers.at(1)),
-    readoutBuffer(lineBuffers.at(0))
+    loops(loops),
+    timeScale(timeScale),
+    addressOffset(addressOffset),
+    addressMask(addressMask),
+    addressDecoder(addressDecoder),
+    dramAddressOffset(dramAddressOffset)
 {
-    readoutBuffer->reserve(LINE_BUFFER_SIZE);
-    parseBuffer->reserve(LINE_BUFFER_SIZE);
+    if (loops == 0)
+        SC_REPORT_FATAL("StlPlayer", "Number of loops must be at least 1.");
 
-    if (!traceFile.is_open())
-        SC_REPORT_FATAL("StlPlayer",
-                        (std::string("Could not open trace ") + tracePath.data()).c_str());
+    if (timeScale <= 0.0)
+        SC_REPORT_FATAL("StlPlayer", "Time scale must be a positive number.");
 
+    // Traces that are replayed several times or by several players are parsed only once if they
+    // fit into memory. All other traces are streamed from the file.
+    if (loops > 1 || sharedTrace)
     {
-        std::string line;
-        while (std::getline(traceFile, line))
-        {
-            if (line.size() > 1 && line[0] != '#')
-                numberOfLines++;
-        }
-        if (numberOfLines == 0)
-            SC_REPORT_FATAL("StlPlayer", (std::string("Empty trace ") + tracePath.data()).c_str());
-        traceFile.clear();
-        traceFile.seekg(0);
+        std::size_t estimatedLineSize =
+            sizeof(TraceEntry) + (storageEnabled ? defaultDataLength : 0);
+        trace = TraceCache::load(tracePath,
+                                 defaultDataLength,
+                                 storageEnabled,
+                                 MAX_CACHE_SIZE / estimatedLineSize,
+                                 parser);
     }
 
-    parseTraceFile();
-    readoutIt = readoutBuffer->cend();
+    if (trace)
+    {
+        numberOfLines = trace->entries.size();
+        readoutIt = trace->entries.cbegin();
+        predecode();
+    }
+    else
+    {
+        if (!parser.has_value())
+            parser.emplace(tracePath, defaultDataLength, storageEnabled);
+
+        numberOfLines = parser->numberOfLines();
+
+        parseBuffer = std::make_shared<TraceBlock>();
+        readoutBuffer = std::make_shared<TraceBlock>();
+        parseBuffer->entries.reserve(LINE_BUFFER_SIZE);
+        readoutBuffer->entries.reserve(LINE_BUFFER_SIZE);
+
+        parser->parse(*parseBuffer, LINE_BUFFER_SIZE);
+        trace = readoutBuffer;
+        readoutIt = trace->entries.cend();
+    }
 }
 
 Request StlPlayer::nextRequest()
 {
-    if (readoutIt == readoutBuffer->cend())
+    if (readoutIt == trace->entries.cend())
     {
-        readoutIt = swapBuffers();
-        if (readoutIt == readoutBuffer->cend())
+        if (parser.has_value())
+            readoutIt = swapBuffers();
+
+        if (readoutIt == trace->entries.cend())
         {
-            if (parserThread.joinable())
-                parserThread.join();
+            if (currentLoop + 1 < loops)
+            {
+                // The end of the trace is reached. Start over again.
+                readoutIt = rewind();
+            }
+            else
+            {
+                if (parserThread.joinable())
+                    parserThread.join();
 
-            // The file is read in completely. Nothing more to do.
-            return Request{Request::Command::Stop};
+                // The file is read in completely. Nothing more to do.
+                return Request{Request::Command::Stop};
+            }
         }
     }
 
+    const TraceEntry& entry = *readoutIt;
+
+    sc_core::sc_time timestamp = playerPeriod * (static_cast<double>(entry.cycle) * timeScale);
     sc_core::sc_time delay;
     if (traceType == TraceType::Absolute)
     {
-        bool behindSchedule = sc_core::sc_time_stamp() > readoutIt->delay;
-        delay =
-            behindSchedule ? sc_core::SC_ZERO_TIME : readoutIt->delay - sc_core::sc_time_stamp();
+        lastTimestamp = timestamp;
+        timestamp += loopOffset;
+
+        bool behindSchedule = sc_core::sc_time_stamp() > timestamp;
+        delay = behindSchedule ? sc_core::SC_ZERO_TIME : timestamp - sc_core::sc_time_stamp();
     }
     else // if (traceType == TraceType::Relative)
     {
-        delay = readoutIt->delay;
+        delay = timestamp;
     }
 
-    Request request(*readoutIt);
+    Request request;
+    request.command = entry.command;
+    request.address = (entry.address & addressMask) + addressOffset;
+    request.length = entry.length;
     request.delay = delay;
 
+    if (storageEnabled && entry.command == Request::Command::Write)
+        request.data = trace->data.data() + entry.dataOffset;
+
+    if (addressDecoder != nullptr)
+    {
+        request.decodedAddress = &decodedAddresses[readoutIt - trace->entries.cbegin()];
+        request.mappingId = addressDecoder->getMappingId();
+    }
+
     readoutIt++;
     return request;
 }
 
-void StlPlayer::parseTraceFile()
+std::vector<TraceEntry>::const_iterator StlPlayer::swapBuffers()
 {
-    unsigned parsedLines = 0;
-    parseBuffer->clear();
+    // Wait for parser to finish
+    if (parserThread.joinable())
+        parserThread.join();
 
-    while (traceFile && !traceFile.eof() && parsedLines < LINE_BUFFER_SIZE)
-    {
-        // Get a new line from the input file.
-        std::string line;
-        std::getline(traceFile, line);
-        currentLine++;
+    // Swap buffers
+    std::swap(readoutBuffer, parseBuffer);
+    trace = readoutBuffer;
 
-        // If the line is empty (\n or \r\n) or starts with '#' (comment) the transaction is
-        // ignored.
-        if (line.size() <= 1 || line.at(0) == '#')
-            continue;
+    // Start new parser thread
+    parserThread = std::thread([this] { parser->parse(*parseBuffer, LINE_BUFFER_SIZE); });
 
-        parsedLines++;
-        parseBuffer->emplace_back();
-        Request& content = parseBuffer->back();
+    predecode();
+    return trace->entries.cbegin();
+}
 
-        // Trace files MUST provide timestamp, command and address for every
-        // transaction. The data information depends on the storage mode
-        // configuration.
-        std::string element;
-        std::istringstream iss;
+std::vector<TraceEntry>::const_iterator StlPlayer::rewind()
+{
+    currentLoop++;
 
-        iss.str(line);
+    // Timestamps of absolute traces continue after the last request of the previous pass.
+    loopOffset += lastTimestamp + playerPeriod * timeScale;
 
-        try
-        {
-            // Get the timestamp for the transaction.
-            iss >> element;
-            if (element.empty())
-                SC_REPORT_FATAL(
-                    "StlPlayer",
-                    ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
-
-            content.delay = playerPeriod * static_cast<double>(std::stoull(element));
-
-            // Get the optional burst length and command
-            iss >> element;
-            if (element.empty())
-                SC_REPORT_FATAL(
-                    "StlPlayer",
-                    ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
-
-            if (element.at(0) == '(')
-            {
-                element.erase(0, 1);
-                content.length = std::stoul(element);
-                iss >> element;
-                if (element.empty())
-                    SC_REPORT_FATAL(
-                        "StlPlayer",
-                        ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
-            }
-            else
-                content.length = defaultDataLength;
+    if (!parser.has_value())
+        return trace->entries.cbegin();
 
-            if (element == "read")
-                content.command = Request::Command::Read;
-            else if (element == "write")
-                content.command = Request::Command::Write;
-            else
-                SC_REPORT_FATAL(
-                    "StlPlayer",
-                    ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
-
-            // Get the address.
-            iss >> element;
-            if (element.empty())
-                SC_REPORT_FATAL(
-                    "StlPlayer",
-                    ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
-            content.address = std::stoull(element, nullptr, 16);
-
-            // Get the data if necessary.
-            if (storageEnabled && content.command == Request::Command::Write)
-            {
-                // The input trace file must provide the data to be stored into the memory.
-                iss >> element;
-
-                // Check if data length in the trace file is correct.
-                // We need two characters to represent 1 byte in hexadecimal. Offset for 0x
-                // prefix.
-                if (element.length() != (content.length * 2 + 2))
-                    SC_REPORT_FATAL(
-                        "StlPlayer",
-                        ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
-
-                // Set data
-                for (unsigned i = 0; i < content.length; i++)
-                    content.data.emplace_back(static_cast<unsigned char>(
-                        std::stoi(element.substr(i * 2 + 2, 2), nullptr, 16)));
-            }
-        }
-        catch (...)
-        {
-            SC_REPORT_FATAL(
-                "StlPlayer",
-                ("Malformed trace file line " + std::to_string(currentLine) + ".").c_str());
-        }
-    }
+    if (parserThread.joinable())
+        parserThread.join();
+
+    parser->rewind();
+    parser->parse(*parseBuffer, LINE_BUFFER_SIZE);
+    return swapBuffers();
 }
 
-std::vector<Request>::const_iterator StlPlayer::swapBuffers()
+void StlPlayer::predecode()
 {
-    // Wait for parser to finish
-    if (parserThread.joinable())
-        parserThread.join();
+    if (addressDecoder == nullptr)
+        return;
 
-    // Swap buffers
-    std::swap(readoutBuffer, parseBuffer);
+    // The decoder sees the address after the address offset of DRAMSys has been removed.
+    std::size_t count = trace->entries.size();
+    encodedAddresses.resize(count);
+    decodedAddresses.resize(count);
 
-    // Start new parser thread
-    parserThread = std::thread(&StlPlayer::parseTraceFile, this);
+    for (std::size_t i = 0; i < count; i++)
+        encodedAddresses[i] =
+            (trace->entries[i].address & addressMask) + addressOffset - dramAddressOffset;
 
-    return readoutBuffer->cbegin();
+    addressDecoder->decodeAddresses(encodedAddresses.data(), decodedAddresses.data(), count);
 }
@@ -40,15 +40,17 @@
 
 #pragma once
 
+#include "StlParser.h"
 #include "simulator/request/Request.h"
 #include "simulator/request/RequestProducer.h"
 
+#include <DRAMSys/simulation/AddressDecoder.h>
+
 #include <systemc>
 #include <tlm>
 
-#include <array>
-#include <fstream>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -65,32 +67,60 @@ public:
               unsigned int clkMhz,
               unsigned int defaultDataLength,
               TraceType traceType,
-              bool storageEnabled);
+              bool storageEnabled,
+              uint64_t loops,
+              double timeScale,
+              uint64_t addressOffset,
+              uint64_t addressMask,
+              const DRAMSys::AddressDecoder* addressDecoder = nullptr,
+              uint64_t dramAddressOffset = 0,
+              bool sharedTrace = false);
 
     Request nextRequest() override;
 
-    uint64_t totalRequests() override { return numberOfLines; }
+    uint64_t totalRequests() override { return numberOfLines * loops; }
 
 private:
-    void parseTraceFile();
-    std::vector<Request>::const_iterator swapBuffers();
+    std::vector<TraceEntry>::const_iterator swapBuffers();
+    std::vector<TraceEntry>::const_iterator rewind();
+    void predecode();
 
     static constexpr std::size_t LINE_BUFFER_SIZE = 10000;
 
+    // Upper bound for the estimated memory footprint of a trace that is kept in the trace cache.
+    static constexpr std::size_t MAX_CACHE_SIZE = std::size_t(1) << 30;
+
     const TraceType traceType;
     const bool storageEnabled;
     const sc_core::sc_time playerPeriod;
-    const unsigned int defaultDataLength;
 
-    std::ifstream traceFile;
-    uint64_t currentLine = 0;
+    const uint64_t loops;
+    const double timeScale;
+    const uint64_t addressOffset;
+    const uint64_t addressMask;
+
     uint64_t numberOfLines = 0;
+    uint64_t currentLoop = 0;
+    sc_core::sc_time loopOffset;
+    sc_core::sc_time lastTimestamp;
 
-    std::array<std::shared_ptr<std::vector<Request>>, 2> lineBuffers;
-    std::shared_ptr<std::vector<Request>> parseBuffer;
-    std::shared_ptr<std::vector<Request>> readoutBuffer;
+    // The parser is only used if the trace is not kept in the trace cache and has to be streamed
+    // from the file.
+    std::optional<StlParser> parser;
+    std::shared_ptr<TraceBlock> parseBuffer;
+    std::shared_ptr<TraceBlock> readoutBuffer;
 
-    std::vector<Request>::const_iterator readoutIt;
+    // Either the shared trace from the trace cache or the current readout buffer.
+    std::shared_ptr<const TraceBlock> trace;
+    std::vector<TraceEntry>::const_iterator readoutIt;
 
     std::thread parserThread;
+
+    // If an address decoder is given, the addresses of the current trace block are decoded in bulk
+    // whenever a new block becomes available and handed to the memory controller with each
+    // request.
+    const DRAMSys::AddressDecoder* addressDecoder;
+    const uint64_t dramAddressOffset;
+    std::vector<uint64_t> encodedAddresses;
+    std::vector<DRAMSys::DecodedAddress> decodedAddresses;
 };
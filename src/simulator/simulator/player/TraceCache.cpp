@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TraceCache.h"
+
+#include <filesystem>
+
+std::mutex TraceCache::mutex;
+std::map<TraceCache::Key, std::weak_ptr<const TraceBlock>> TraceCache::traces;
+
+std::shared_ptr<const TraceBlock> TraceCache::load(std::string_view tracePath,
+                                                   unsigned int defaultDataLength,
+                                                   bool storageEnabled,
+                                                   uint64_t maxLines,
+                                                   std::optional<StlParser>& parser)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // The default data length and the storage mode influence the parsed contents.
+    std::error_code error;
+    std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(tracePath, error);
+    Key key{error ? std::string(tracePath) : canonicalPath.string(),
+            defaultDataLength,
+            storageEnabled};
+
+    if (auto trace = traces[key].lock())
+        return trace;
+
+    parser.emplace(tracePath, defaultDataLength, storageEnabled);
+    if (parser->numberOfLines() > maxLines)
+        return nullptr;
+
+    auto trace = std::make_shared<TraceBlock>();
+    trace->entries.reserve(parser->numberOfLines());
+    parser->parse(*trace, parser->numberOfLines());
+    parser.reset();
+
+    traces[key] = trace;
+    return trace;
+}
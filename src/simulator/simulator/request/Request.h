@@ -35,6 +35,9 @@
 
 #pragma once
 
+#include <DRAMSys/simulation/AddressDecoder.h>
+
+#include <cstddef>
 #include <cstdint>
 #include <systemc>
 
@@ -49,5 +52,14 @@ struct Request
     uint64_t address{};
     std::size_t length{};
     sc_core::sc_time delay{};
-    std::vector<unsigned char> data{};
+
+    // Optional write data of size length. The buffer is owned by the request producer and remains
+    // valid until its next request is fetched.
+    const unsigned char* data = nullptr;
+
+    // Optional DRAM coordinates of the address that were decoded in advance by the producer with
+    // the address mapping identified by mappingId. The memory controller falls back to decoding
+    // the address itself if the mapping does not match.
+    const DRAMSys::DecodedAddress* decodedAddress = nullptr;
+    uint64_t mappingId = 0;
 };
@@ -35,6 +35,8 @@
 
 #include "RequestIssuer.h"
 
+#include <cstring>
+
 RequestIssuer::RequestIssuer(sc_core::sc_module_name const& name,
                              MemoryManager& memoryManager,
                              unsigned int clkMhz,
@@ -42,7 +44,8 @@ RequestIssuer::RequestIssuer(sc_core::sc_module_name const& name,
                              std::optional<unsigned int> maxPendingWriteRequests,
                              std::function<Request()> nextRequest,
                              std::function<void()> transactionFinished,
-                             std::function<void()> terminate) :
+                             std::function<void()> terminate,
+                             LatencyCallback latencyRecorded) :
     sc_module(name),
     payloadEventQueue(this, &RequestIssuer::peqCallback),
     memoryManager(memoryManager),
@@ -51,7 +54,8 @@ RequestIssuer::RequestIssuer(sc_core::sc_module_name const& name,
     maxPendingWriteRequests(maxPendingWriteRequests),
     transactionFinished(std::move(transactionFinished)),
     terminate(std::move(terminate)),
-    nextRequest(std::move(nextRequest))
+    nextRequest(std::move(nextRequest)),
+    latencyRecorded(std::move(latencyRecorded))
 {
     SC_THREAD(sendNextRequest);
     iSocket.register_nb_transport_bw(this, &RequestIssuer::nb_transport_bw);
@@ -67,9 +71,16 @@ void RequestIssuer::sendNextRequest()
         return;
     }
 
-    tlm::tlm_generic_payload& payload = memoryManager.allocate(request.length);
+    // Only writes without data of their own depend on the initial content of the buffer
+    bool initializeData = request.command == Request::Command::Write && request.data == nullptr;
+    tlm::tlm_generic_payload& payload = memoryManager.allocate(request.length, initializeData);
     payload.acquire();
     payload.set_address(request.address);
+
+    if (request.decodedAddress != nullptr)
+        DRAMSys::DecodedAddressExtension::setAutoExtension(
+            payload, request.mappingId, *request.decodedAddress);
+
     payload.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
     payload.set_dmi_allowed(false);
     payload.set_byte_enable_length(0);
@@ -78,7 +89,8 @@ void RequestIssuer::sendNextRequest()
     payload.set_command(request.command == Request::Command::Read ? tlm::TLM_READ_COMMAND
                                                                   : tlm::TLM_WRITE_COMMAND);
 
-    std::copy(request.data.cbegin(), request.data.cend(), payload.get_data_ptr());
+    if (request.data != nullptr)
+        std::memcpy(payload.get_data_ptr(), request.data, request.length);
 
     tlm::tlm_phase phase = tlm::BEGIN_REQ;
     sc_core::sc_time delay = request.delay;
@@ -98,6 +110,10 @@ void RequestIssuer::sendNextRequest()
     }
 
     delay = sendingTime - sc_core::sc_time_stamp();
+
+    if (latencyRecorded)
+        sendingTimes.emplace(&payload, sendingTime);
+
     iSocket->nb_transport_fw(payload, phase, delay);
 
     if (request.command == Request::Command::Read)
@@ -139,6 +155,14 @@ void RequestIssuer::peqCallback(tlm::tlm_generic_payload& payload, const tlm::tl
         sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
         iSocket->nb_transport_fw(payload, nextPhase, delay);
 
+        if (latencyRecorded)
+        {
+            auto sendingTimeIt = sendingTimes.find(&payload);
+            latencyRecorded(sendingTimeIt->second,
+                            sc_core::sc_time_stamp() - sendingTimeIt->second);
+            sendingTimes.erase(sendingTimeIt);
+        }
+
         payload.release();
 
         transactionFinished();
@@ -44,12 +44,16 @@
 #include <tlm_utils/simple_initiator_socket.h>
 
 #include <optional>
+#include <unordered_map>
 
 class RequestIssuer : sc_core::sc_module
 {
 public:
     tlm_utils::simple_initiator_socket<RequestIssuer> iSocket;
 
+    // Called with the sending time and the latency of every finished transaction
+    using LatencyCallback = std::function<void(sc_core::sc_time, sc_core::sc_time)>;
+
     RequestIssuer(sc_core::sc_module_name const& name,
                   MemoryManager& memoryManager,
                   unsigned int clkMhz,
@@ -57,7 +61,8 @@ public:
                   std::optional<unsigned int> maxPendingWriteRequests,
                   std::function<Request()> nextRequest,
                   std::function<void()> transactionFinished,
-                  std::function<void()> terminate);
+                  std::function<void()> terminate,
+                  LatencyCallback latencyRecorded = {});
     SC_HAS_PROCESS(RequestIssuer);
 
 private:
@@ -82,6 +87,9 @@ private:
     std::function<void()> terminate;
     std::function<Request()> nextRequest;
 
+    LatencyCallback latencyRecorded;
+    std::unordered_map<tlm::tlm_generic_payload*, sc_core::sc_time> sendingTimes;
+
     void sendNextRequest();
     bool nextRequestSendable() const;
 
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2023, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <DRAMSys/config/AddressMapping.h>
+#include <DRAMSys/simulation/AddressDecoder.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace DRAMSys;
+
+namespace
+{
+
+// Straightforward decoder that extracts every bit of the address on its own, the compiled masks
+// and tables of the AddressDecoder must produce the same coordinates for every mapping
+class ReferenceDecoder
+{
+public:
+    explicit ReferenceDecoder(const Config::AddressMapping& mapping)
+    {
+        addBits(mapping.CHANNEL_BIT, channelBits);
+        addBits(mapping.RANK_BIT, rankBits);
+        addBits(mapping.PSEUDOCHANNEL_BIT, rankBits);
+        addBits(mapping.BANKGROUP_BIT, bankGroupBits);
+        addBits(mapping.BANK_BIT, bankBits);
+        addBits(mapping.ROW_BIT, rowBits);
+        addBits(mapping.COLUMN_BIT, columnBits);
+        addBits(mapping.BYTE_BIT, byteBits);
+    }
+
+    [[nodiscard]] DecodedAddress decode(uint64_t address) const
+    {
+        // Every gate sets its first bit to the parity of all its bits in the original address
+        uint64_t xored = address;
+        for (const auto& gate : gates)
+        {
+            uint64_t parity = 0;
+            for (unsigned bit : gate)
+                parity ^= (address >> bit) & 1;
+
+            xored &= ~(UINT64_C(1) << gate.front());
+            xored |= parity << gate.front();
+        }
+
+        auto extract = [xored](const std::vector<unsigned>& bits)
+        {
+            unsigned value = 0;
+            for (unsigned position = 0; position < bits.size(); position++)
+                value |= static_cast<unsigned>((xored >> bits[position]) & 1) << position;
+            return value;
+        };
+
+        DecodedAddress decoded;
+        decoded.channel = extract(channelBits);
+        decoded.rank = extract(rankBits);
+        decoded.bankgroup = extract(bankGroupBits) + decoded.rank * (1U << bankGroupBits.size());
+        decoded.bank = extract(bankBits) + decoded.bankgroup * (1U << bankBits.size());
+        decoded.row = extract(rowBits);
+        decoded.column = extract(columnBits);
+        decoded.byte = extract(byteBits);
+        return decoded;
+    }
+
+private:
+    void addBits(const std::optional<std::vector<Config::AddressMapping::BitEntry>>& entries,
+                 std::vector<unsigned>& bits)
+    {
+        if (!entries)
+            return;
+
+        for (const auto& entry : *entries)
+        {
+            if (const auto* bit = std::get_if<unsigned>(&entry))
+            {
+                bits.push_back(*bit);
+            }
+            else
+            {
+                const auto& gate = std::get<std::vector<unsigned>>(entry);
+                bits.push_back(gate.front());
+                gates.push_back(gate);
+            }
+        }
+    }
+
+    std::vector<std::vector<unsigned>> gates;
+    std::vector<unsigned> channelBits;
+    std::vector<unsigned> rankBits;
+    std::vector<unsigned> bankGroupBits;
+    std::vector<unsigned> bankBits;
+    std::vector<unsigned> rowBits;
+    std::vector<unsigned> columnBits;
+    std::vector<unsigned> byteBits;
+};
+
+void expectEqual(const DecodedAddress& actual, const DecodedAddress& expected)
+{
+    EXPECT_EQ(actual.channel, expected.channel);
+    EXPECT_EQ(actual.rank, expected.rank);
+    EXPECT_EQ(actual.bankgroup, expected.bankgroup);
+    EXPECT_EQ(actual.bank, expected.bank);
+    EXPECT_EQ(actual.row, expected.row);
+    EXPECT_EQ(actual.column, expected.column);
+    EXPECT_EQ(actual.byte, expected.byte);
+}
+
+void compareWithReference(const Config::AddressMapping& mapping)
+{
+    AddressDecoder decoder(mapping);
+    ReferenceDecoder reference(mapping);
+
+    std::mt19937_64 generator(0);
+    std::vector<uint64_t> addresses = {0, decoder.maxAddress()};
+    for (unsigned index = 0; index < 1000; index++)
+        addresses.push_back(generator() & decoder.maxAddress());
+
+    std::vector<DecodedAddress> batch(addresses.size());
+    decoder.decodeAddresses(addresses.data(), batch.data(), addresses.size());
+
+    for (std::size_t index = 0; index < addresses.size(); index++)
+    {
+        uint64_t address = addresses[index];
+        SCOPED_TRACE("address " + std::to_string(address));
+
+        DecodedAddress expected = reference.decode(address);
+        expectEqual(decoder.decodeAddress(address), expected);
+        expectEqual(batch[index], expected);
+        EXPECT_EQ(decoder.decodeChannel(address), expected.channel);
+        EXPECT_EQ(decoder.encodeAddress(expected), address);
+    }
+}
+
+Config::AddressMapping parseMapping(const std::string& json)
+{
+    return json_t::parse(json).get<Config::AddressMapping>();
+}
+
+} // namespace
+
+TEST(AddressDecoder, ShippedMappingsMatchReference)
+{
+    std::filesystem::path directory =
+        std::filesystem::path(DRAMSYS_RESOURCE_DIR) / Config::AddressMapping::SUB_DIR;
+
+    unsigned mappings = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory))
+    {
+        if (entry.path().extension() != ".json")
+            continue;
+
+        SCOPED_TRACE(entry.path().filename().string());
+
+        std::ifstream file(entry.path());
+        auto mapping = json_t::parse(file)
+                           .at(std::string(Config::AddressMapping::KEY))
+                           .get<Config::AddressMapping>();
+        compareWithReference(mapping);
+        mappings++;
+    }
+
+    EXPECT_GT(mappings, 0U);
+}
+
+TEST(AddressDecoder, XorMappingMatchesReference)
+{
+    compareWithReference(parseMapping(R"({
+        "BYTE_BIT": [0, 1, 2],
+        "COLUMN_BIT": [3, 4, 5, 6, 7, 8, 9, 10, 11, 12],
+        "BANKGROUP_BIT": [[13, 17, 21], [14, 18]],
+        "BANK_BIT": [[15, 19], 16],
+        "ROW_BIT": [17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30],
+        "RANK_BIT": [[31, 20]],
+        "CHANNEL_BIT": [32]
+    })"));
+}
+
+// The bits of a field do not ascend, which rules out PEXT and PDEP
+TEST(AddressDecoder, UnorderedMappingMatchesReference)
+{
+    compareWithReference(parseMapping(R"({
+        "BYTE_BIT": [0, 1],
+        "COLUMN_BIT": [2, 3, 12, 11, 10, 9, 8, 7, 6, 5],
+        "BANK_BIT": [4, 15, 13],
+        "PSEUDOCHANNEL_BIT": [14],
+        "ROW_BIT": [29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16]
+    })"));
+}